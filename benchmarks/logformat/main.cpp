@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string_view>
+
+/* modern.cpp.core */
+#include <Logger.h>
+#include <Logger_json.h>
+#include <Logger_sink.h>
+
+namespace {
+
+  /** @brief Records per scenario. */
+  constexpr std::int32_t records = 1000000;
+
+  /**
+   * @brief Sink, that discards every record.
+   */
+  class NullSink : public vx::logger::Sink {
+
+  public:
+    /**
+     * @copydoc Sink::write()
+     */
+    void write( [[maybe_unused]] const vx::logger::Entry &_entry ) noexcept override { /* discard */ }
+  };
+
+  /**
+   * @brief Run a scenario and print the time per record.
+   * @param _name   Name of the scenario.
+   * @param _function   Emission of one record.
+   */
+  void run( std::string_view _name,
+            void ( *_function )( std::int32_t ) ) {
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( std::int32_t record = 0; record < records; record++ ) {
+
+      _function( record );
+    }
+    const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+    std::cout << std::left << std::setw( 12 ) << _name << std::right << std::fixed << std::setprecision( 1 )
+              << std::setw( 10 ) << duration.count() / records << " ns/record" << std::endl;
+  }
+}
+
+std::int32_t main() {
+
+  using namespace std::literals;
+
+  vx::logger::Configuration::instance().setAvoidLogBelow( vx::logger::Severity::Verbose );
+  vx::logger::SinkRegistry &sinks = vx::logger::SinkRegistry::instance();
+  const auto sink = std::make_shared<NullSink>();
+  sinks.add( sink );
+  sinks.remove( sinks.console() );
+
+  for ( std::int32_t round = 0; round < 2; round++ ) {
+
+    run( "stream", []( std::int32_t _record ) { logInfo() << "parse"sv << _record << "took"sv << 3.5 << "ms"sv; } );
+    run( "format", []( std::int32_t _record ) { logInfo( "{} {} took {} ms", "parse"sv, _record, 3.5 ); } );
+    run( "fields", []( std::int32_t _record ) { logInfo() << "parse"sv << vx::logger::kv( "record", _record ) << vx::logger::kv( "ms", 3.5 ); } );
+  }
+
+  /* Same records as JSON lines. */
+  const auto json = std::make_shared<vx::logger::JsonSink>( sink );
+  sinks.remove( sink );
+  sinks.add( json );
+  for ( std::int32_t round = 0; round < 2; round++ ) {
+
+    run( "json stream", []( std::int32_t _record ) { logInfo() << "parse"sv << _record << "took"sv << 3.5 << "ms"sv; } );
+    run( "json fields", []( std::int32_t _record ) { logInfo() << "parse"sv << vx::logger::kv( "record", _record ) << vx::logger::kv( "ms", 3.5 ); } );
+  }
+
+  sinks.add( sinks.console() );
+  sinks.remove( json );
+  return EXIT_SUCCESS;
+}
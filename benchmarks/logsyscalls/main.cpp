@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* system header */
+#include <fcntl.h>
+#include <unistd.h>
+
+/* c header */
+#include <cstdint> // std::int32_t, std::uint64_t
+#include <cstdio> // std::fflush
+
+/* stl header */
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* modern.cpp.core */
+#include <Logger.h>
+#include <Timestamp.h>
+
+namespace {
+
+  /** @brief Records per thread and scenario. */
+  constexpr std::int32_t records = 50000;
+
+  /** @brief Temporary file, that receives stdout during a scenario. */
+  constexpr const char *outputFile = "logsyscalls.out";
+
+  /**
+   * @brief Number of write system calls of this process so far.
+   * @return Write system calls or 0, if unknown.
+   */
+  std::uint64_t writeSyscalls() {
+
+    std::ifstream io( "/proc/self/io" );
+    std::string key {};
+    std::uint64_t value = 0;
+    while ( io >> key >> value ) {
+
+      if ( key == "syscw:" ) {
+
+        return value;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Emission of a record like the previous Logger: streaming piece by piece into std::cout.
+   * @param _thread   Thread number.
+   * @param _record   Record number.
+   */
+  void piecewise( std::int32_t _thread,
+                  std::int32_t _record ) {
+
+    std::ostream stream( std::cout.rdbuf() );
+    stream << vx::timestamp::iso8601( vx::timestamp::Precision::MicroSeconds ) << ' ';
+    stream << "   \x1b[32;1m[INFO]\x1b[0m" << ' ';
+    stream << "main.cpp:" << __LINE__ << ' ' << "piecewise" << ' ';
+    stream << std::quoted( "thread" ) << ' ' << _thread << ' ' << std::quoted( "record" ) << ' ' << _record << ' ';
+    stream << std::endl;
+  }
+
+  /**
+   * @brief Emission of a record with the Logger.
+   * @param _thread   Thread number.
+   * @param _record   Record number.
+   */
+  void logger( std::int32_t _thread,
+               std::int32_t _record ) {
+
+    logInfo() << "thread" << _thread << "record" << _record;
+  }
+
+  /**
+   * @brief Count lines, that do not consist of exactly one record.
+   * @return Number of torn lines.
+   */
+  std::size_t tornLines() {
+
+    std::ifstream input( outputFile );
+    std::string line {};
+    std::size_t torn = 0;
+    while ( std::getline( input, line ) ) {
+
+      const std::size_t first = line.find( "[INFO]" );
+      if ( first == std::string::npos || line.find( "[INFO]", first + 1 ) != std::string::npos || !line.ends_with( ' ' ) ) {
+
+        torn++;
+      }
+    }
+    return torn;
+  }
+
+  /**
+   * @brief Run a scenario with stdout redirected into a file and print the result.
+   * @param _name   Name of the scenario.
+   * @param _threads   Number of logging threads.
+   * @param _function   Emission of one record.
+   */
+  void run( const std::string &_name,
+            std::int32_t _threads,
+            void ( *_function )( std::int32_t, std::int32_t ) ) {
+
+    std::cout.flush();
+    std::fflush( stdout );
+    const std::int32_t saved = ::dup( STDOUT_FILENO );
+    const std::int32_t file = ::open( outputFile, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    ::dup2( file, STDOUT_FILENO );
+    ::close( file );
+
+    const std::uint64_t syscallsBefore = writeSyscalls();
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads {};
+    for ( std::int32_t thread = 0; thread < _threads; thread++ ) {
+
+      threads.emplace_back( [ _function, thread ] {
+
+        for ( std::int32_t record = 0; record < records; record++ ) {
+
+          _function( thread, record );
+        }
+      } );
+    }
+    for ( std::thread &thread : threads ) {
+
+      thread.join();
+    }
+    /* Disabling the asynchronous mode waits for the background writer. */
+    vx::logger::Configuration::instance().setAsync( false );
+    std::cout.flush();
+    std::fflush( stdout );
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    const std::uint64_t syscalls = writeSyscalls() - syscallsBefore;
+
+    ::dup2( saved, STDOUT_FILENO );
+    ::close( saved );
+
+    const double total = static_cast<double>( _threads ) * records;
+    std::cerr << std::left << std::setw( 20 ) << _name << std::right
+              << std::setw( 8 ) << _threads
+              << std::setw( 12 ) << std::fixed << std::setprecision( 0 ) << total / seconds.count()
+              << std::setw( 18 ) << std::setprecision( 3 ) << static_cast<double>( syscalls ) / total
+              << std::setw( 12 ) << tornLines() << std::endl;
+  }
+}
+
+std::int32_t main() {
+
+  vx::logger::Configuration::instance().setAvoidLogBelow( vx::logger::Severity::Verbose );
+
+  /* Write system calls are counted with /proc/self/io, which exists on Linux only. */
+  std::cerr << std::left << std::setw( 20 ) << "scenario" << std::right
+            << std::setw( 8 ) << "threads"
+            << std::setw( 12 ) << "records/s"
+            << std::setw( 18 ) << "syscalls/record"
+            << std::setw( 12 ) << "torn lines" << std::endl;
+
+  for ( const std::int32_t threads : { 1, 4 } ) {
+
+    run( "piecewise (before)", threads, piecewise );
+    run( "logger sync", threads, logger );
+    vx::logger::Configuration::instance().setAsync( true );
+    run( "logger async", threads, logger );
+  }
+  ::unlink( outputFile );
+  return EXIT_SUCCESS;
+}
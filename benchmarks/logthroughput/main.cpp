@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstdint> // std::int32_t, std::int64_t
+
+/* stl header */
+#include <algorithm>
+#include <any>
+#include <chrono>
+#include <cstdio> // std::remove
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/* modern.cpp.core */
+#include <Logger.h>
+#include <Logger_any.h>
+#include <Logger_enum.h>
+#include <Logger_file.h>
+#include <Logger_sink.h>
+
+namespace {
+
+  /** @brief Records per thread and scenario. */
+  constexpr std::int32_t records = 200000;
+
+  /** @brief Untimed records per thread before a scenario, to fill caches. */
+  constexpr std::int32_t warmup = 1000;
+
+  /** @brief File, that receives the records of the file sink. */
+  constexpr const char *outputFile = "logthroughput.log";
+
+  /**
+   * @brief Sink, that discards every record.
+   */
+  class NullSink : public vx::logger::Sink {
+
+  public:
+    /**
+     * @copydoc Sink::write()
+     */
+    void write( [[maybe_unused]] const vx::logger::Entry &_entry ) noexcept override { /* discard */ }
+  };
+
+  /**
+   * @brief Emission of one record.
+   */
+  using Emit = void ( * )( std::int32_t );
+
+  /**
+   * @brief Scenarios, one value type per record.
+   */
+  struct Scenario {
+
+    /**
+     * @brief Name of the scenario.
+     */
+    std::string_view name;
+
+    /**
+     * @brief Emission of one record.
+     */
+    Emit emit;
+  };
+
+  /**
+   * @brief Latency of a sorted sample at a percentile.
+   * @param _samples   Sorted latencies.
+   * @param _percentile   Percentile between 0 and 100.
+   * @return Latency in nanoseconds.
+   */
+  std::int64_t percentile( const std::vector<std::int64_t> &_samples,
+                           double _percentile ) {
+
+    const auto index = static_cast<std::size_t>( _percentile / 100.0 * static_cast<double>( _samples.size() - 1 ) );
+    return _samples[ index ];
+  }
+
+  /**
+   * @brief Run a scenario on several threads and print records/s and latency percentiles.
+   * @param _sink   Name of the sink.
+   * @param _scenario   Scenario to run.
+   * @param _threads   Number of logging threads.
+   */
+  void run( std::string_view _sink,
+            const Scenario &_scenario,
+            std::int32_t _threads ) {
+
+    std::vector<std::vector<std::int64_t>> samples( static_cast<std::size_t>( _threads ) );
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads {};
+    for ( std::vector<std::int64_t> &latencies : samples ) {
+
+      latencies.reserve( records );
+      threads.emplace_back( [ &_scenario, &latencies ] {
+
+        for ( std::int32_t record = 0; record < records; record++ ) {
+
+          const auto before = std::chrono::steady_clock::now();
+          _scenario.emit( record );
+          latencies.push_back( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - before ).count() );
+        }
+      } );
+    }
+    for ( std::thread &thread : threads ) {
+
+      thread.join();
+    }
+    vx::logger::SinkRegistry::instance().flush();
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+    std::vector<std::int64_t> latencies {};
+    latencies.reserve( static_cast<std::size_t>( _threads ) * records );
+    for ( const std::vector<std::int64_t> &thread : samples ) {
+
+      latencies.insert( latencies.end(), thread.begin(), thread.end() );
+    }
+    std::sort( latencies.begin(), latencies.end() );
+
+    const double total = static_cast<double>( _threads ) * records;
+    std::cout << std::left << std::setw( 6 ) << _sink << std::setw( 11 ) << _scenario.name << std::right
+              << std::setw( 8 ) << _threads
+              << std::setw( 12 ) << std::fixed << std::setprecision( 0 ) << total / seconds.count()
+              << std::setw( 9 ) << percentile( latencies, 50.0 )
+              << std::setw( 9 ) << percentile( latencies, 90.0 )
+              << std::setw( 9 ) << percentile( latencies, 99.0 )
+              << std::setw( 9 ) << percentile( latencies, 99.9 )
+              << std::setw( 10 ) << latencies.back() << std::endl;
+  }
+
+  /**
+   * @brief Run every scenario single- and multi-threaded with the installed sink.
+   * @param _sink   Name of the sink.
+   * @param _scenarios   Scenarios to run.
+   */
+  void runAll( std::string_view _sink,
+               const std::vector<Scenario> &_scenarios ) {
+
+    for ( const Scenario &scenario : _scenarios ) {
+
+      for ( std::int32_t record = 0; record < warmup; record++ ) {
+
+        scenario.emit( record );
+      }
+      for ( const std::int32_t threads : { 1, 4 } ) {
+
+        run( _sink, scenario, threads );
+      }
+    }
+  }
+}
+
+std::int32_t main() {
+
+  using namespace std::literals;
+
+  const std::vector<Scenario> scenarios {
+
+    { "int", []( std::int32_t _record ) { logInfo() << "int"sv << _record; } },
+    { "double", []( std::int32_t _record ) { logInfo() << "double"sv << _record * 1.25; } },
+    { "string", []( [[maybe_unused]] std::int32_t _record ) {
+
+       static const std::string text = "the quick brown fox jumps over the lazy dog";
+       logInfo() << "string"sv << text;
+     } },
+    { "container", []( [[maybe_unused]] std::int32_t _record ) {
+
+       static const std::vector<std::int32_t> values { 1, 2, 3, 4, 5, 6, 7, 8 };
+       logInfo() << "container"sv << values;
+     } },
+    { "any", []( std::int32_t _record ) { logInfo() << "any"sv << std::any( _record ); } },
+    { "enum", []( std::int32_t _record ) { logInfo() << "enum"sv << static_cast<vx::logger::Severity>( _record % 6 ); } }
+  };
+
+  vx::logger::Configuration::instance().setAvoidLogBelow( vx::logger::Severity::Verbose );
+  vx::logger::SinkRegistry &sinks = vx::logger::SinkRegistry::instance();
+  sinks.remove( sinks.console() );
+
+  /* Latencies include two clock reads per record. */
+  std::cout << std::left << std::setw( 6 ) << "sink" << std::setw( 11 ) << "scenario" << std::right
+            << std::setw( 8 ) << "threads"
+            << std::setw( 12 ) << "records/s"
+            << std::setw( 9 ) << "p50 ns"
+            << std::setw( 9 ) << "p90 ns"
+            << std::setw( 9 ) << "p99 ns"
+            << std::setw( 9 ) << "p99.9 ns"
+            << std::setw( 10 ) << "max ns" << std::endl;
+
+  const auto null = std::make_shared<NullSink>();
+  sinks.add( null );
+  runAll( "null", scenarios );
+  sinks.remove( null );
+
+  const auto file = std::make_shared<vx::logger::FileSink>();
+  if ( !file->open( outputFile ) ) {
+
+    std::cerr << "Could not open " << outputFile << std::endl;
+    return EXIT_FAILURE;
+  }
+  sinks.add( file );
+  runAll( "file", scenarios );
+  sinks.remove( file );
+  std::remove( outputFile );
+
+  sinks.add( sinks.console() );
+  return EXIT_SUCCESS;
+}
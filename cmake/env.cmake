@@ -34,6 +34,11 @@ option(CMAKE_VERBOSE_MAKEFILE "Show the complete build commands" OFF)
 # possibility to disable build steps
 option(CORE_BUILD_EXAMPLES "Build examples for modern.cpp.core" ON)
 option(CORE_BUILD_TESTS "Build tests for modern.cpp.core" ON)
+option(CORE_BUILD_BENCHMARKS "Build benchmarks for modern.cpp.core" OFF)
+
+# logging below this severity is removed at compile time
+set(CORE_LOG_MIN_SEVERITY Verbose CACHE STRING "Minimum severity compiled into vx::logger")
+set_property(CACHE CORE_LOG_MIN_SEVERITY PROPERTY STRINGS Verbose Debug Info Warning Error Fatal)
 
 # General
 set(CMAKE_TLS_VERIFY TRUE)
@@ -114,6 +114,8 @@ set(FMT_ABSTRACT
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#pragma once
+
 /* stl header */
 #include <string_view>
 #include <utility>
@@ -148,6 +150,15 @@ namespace std {
 
     return fmt::vformat( _fmt, fmt::make_format_args( _args... ) )\;
   }
+
+  template <typename... T>
+  using format_string = fmt::format_string<T...>\;
+
+  template <typename OutputIt, typename... T>
+  OutputIt format_to( OutputIt _out, fmt::format_string<T...> _fmt, T &&..._args ) {
+
+    return fmt::format_to( _out, _fmt, std::forward<T>( _args )... )\;
+  }
 }"
 )
 
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <fstream>
+#include <iostream>
+#ifdef HAVE_SPAN
+  #include <span>
+#endif
+
+/* modern.cpp.core */
+#include <Logger_binary.h>
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  /* Usage: logdecoder BINARYLOG */
+#ifdef HAVE_SPAN
+  const std::span args( argv, static_cast<std::size_t>( argc ) );
+  if ( args.size() != 2 ) {
+#else
+  if ( argc != 2 ) {
+#endif
+
+    std::cerr << "Usage: logdecoder BINARYLOG" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+#ifdef HAVE_SPAN
+  std::ifstream input( args[ 1 ], std::ios::in | std::ios::binary );
+#else
+  std::ifstream input( argv[ 1 ], std::ios::in | std::ios::binary );
+#endif
+  if ( !input.is_open() ) {
+
+    std::cerr << "Cannot open binary log." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if ( !vx::logger::binary::decode( input, std::cout ) ) {
+
+    std::cerr << "Binary log is corrupt or has an unsupported version." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -28,81 +28,529 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+/* c header */
+#include <cstdio> // std::snprintf
+
 /* stl header */
 #include <algorithm>
+#include <array>
+#include <charconv> // std::to_chars
 #include <iomanip>
 #include <iostream> // std::streambuf, std::cout
+#include <limits>
 #include <sstream>
 
-/* magic enum */
-#include <magic_enum.hpp>
-
 /* local header */
 #include "Logger.h"
-#include "StringUtils.h"
+#include "Logger_async.h"
+#include "Logger_category.h"
+#include "Logger_context.h"
+#include "Logger_file.h"
+#include "Logger_json.h"
+#include "Logger_recorder.h"
+#include "Logger_sink.h"
 #include "Timestamp.h"
 
 namespace vx::logger {
 
   using timestamp::Precision;
 
-#ifdef _WIN32
-  class WindowsBuffer : public std::stringbuf {
+  /**
+   * @brief Reusable buffer of a record, the stream appends directly into a string.
+   */
+  class RecordBuffer : public std::streambuf {
 
   public:
-    virtual std::int32_t sync() override {
+    /**
+     * @brief Default constructor for RecordBuffer.
+     */
+    RecordBuffer() { m_data.reserve( reserved ); }
+
+    /**
+     * @brief Formatted record.
+     * @return Formatted record.
+     */
+    [[nodiscard]] inline std::string &data() noexcept { return m_data; }
+
+    /**
+     * @brief Structured fields of the record as JSON members.
+     * @return Structured fields.
+     */
+    [[nodiscard]] inline std::string &fields() noexcept { return m_fields; }
+
+    /**
+     * @brief Is the buffer used by a record?
+     * @return True, if a record is using the buffer - otherwise false.
+     */
+    [[nodiscard]] inline bool inUse() const noexcept { return m_inUse; }
+
+    /**
+     * @brief Start a new record with a clean stream.
+     * @return Stream to format the record.
+     */
+    std::ostream &acquire() noexcept {
+
+      constexpr std::streamsize defaultPrecision = 6;
+      m_inUse = true;
+      m_data.clear();
+      m_fields.clear();
+      m_stream.clear();
+      m_stream.flags( std::ios_base::dec | std::ios_base::skipws );
+      m_stream.precision( defaultPrecision );
+      m_stream.width( 0 );
+      m_stream.fill( ' ' );
+      return m_stream;
+    }
+
+    /**
+     * @brief The record is finished.
+     */
+    inline void release() noexcept { m_inUse = false; }
+
+  protected:
+    /**
+     * @brief Append a single character.
+     * @param _char   Character to append.
+     * @return The character or eof, if nothing was appended.
+     */
+    int_type overflow( int_type _char ) override {
+
+      if ( !traits_type::eq_int_type( _char, traits_type::eof() ) ) {
 
-      return 0;
+        m_data.push_back( traits_type::to_char_type( _char ) );
+      }
+      return traits_type::not_eof( _char );
+    }
+
+    /**
+     * @brief Append characters.
+     * @param _data   Characters to append.
+     * @param _size   Number of characters.
+     * @return Number of appended characters.
+     */
+    std::streamsize xsputn( const char_type *_data,
+                            std::streamsize _size ) override {
+
+      m_data.append( _data, static_cast<std::size_t>( _size ) );
+      return _size;
     }
+
+  private:
+    /**
+     * @brief Reserved size, so common records never allocate.
+     */
+    static constexpr std::size_t reserved = 1024;
+
+    /**
+     * @brief Member for formatted record.
+     */
+    std::string m_data {};
+
+    /**
+     * @brief Member for structured fields.
+     */
+    std::string m_fields {};
+
+    /**
+     * @brief Member for stream, that appends into this buffer.
+     */
+    std::ostream m_stream { this };
+
+    /**
+     * @brief Member for usage state.
+     */
+    bool m_inUse = false;
   };
+
+  namespace {
+
+    /**
+     * @brief Record buffer of the current thread.
+     * @return Record buffer of the current thread.
+     */
+    RecordBuffer &threadRecord() noexcept {
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+      thread_local RecordBuffer record {};
+      return record;
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+    }
+
+    /**
+     * @brief Append the context from the outermost to the innermost scope.
+     * @param _context   Innermost context.
+     * @param _text   Text of the record.
+     * @param _fields   Structured fields of the record.
+     */
+    void appendContext( const Context &_context,
+                        std::string &_text,
+                        std::string &_fields ) {
+
+      if ( const Context *previous = _context.previous(); previous != nullptr ) {
+
+        appendContext( *previous, _text, _fields );
+        _text += ' ';
+      }
+      _text += _context.key();
+      _text += '=';
+      _text += _context.value();
+
+      _fields += ',';
+      json::appendKey( _fields, _context.key() );
+      if ( _context.number() ) {
+
+        _fields += _context.value();
+      }
+      else {
+
+        json::appendString( _fields, _context.value() );
+      }
+    }
+
+    /**
+     * @brief Append a floating point number in the layout of a stream with max_digits10, but with the shortest digits, that read back to the same value.
+     * @tparam T   Floating point type.
+     * @param _text   Text of the record.
+     * @param _value   Number to append.
+     */
+    template <typename T>
+    void appendFloat( std::string &_text,
+                      T _value ) {
+
+      constexpr std::int32_t precision = std::numeric_limits<T>::max_digits10;
+      std::array<char, 64> buffer {};
+      char *first = buffer.data();
+      char *last = first + buffer.size();
+#if __cpp_lib_to_chars >= 201611L
+      char *end = std::to_chars( first, last, _value ).ptr;
+
+      /* The shortest form chooses fixed or scientific by length, the stream switches at the exponents -5 and precision. */
+      if ( const char *exponent = std::find( first, end, 'e' ); exponent != end ) {
+
+        std::int32_t power = 0;
+        std::from_chars( exponent[ 1 ] == '+' ? exponent + 2 : exponent + 1, end, power );
+        if ( power >= -4 && power < precision ) {
+
+          end = std::to_chars( first, last, _value, std::chars_format::fixed ).ptr;
+        }
+      }
+      else if ( std::find( first, end, '.' ) - first - ( *first == '-' ? 1 : 0 ) > precision ) {
+
+        end = std::to_chars( first, last, _value, std::chars_format::scientific ).ptr;
+      }
+#else
+      char *end = first + std::min<std::size_t>( buffer.size() - 1, static_cast<std::size_t>( std::snprintf( first, buffer.size(), "%.*g", precision, static_cast<double>( _value ) ) ) );
+#endif
+      _text.append( first, end );
+    }
+
+    /**
+     * @brief Random choice of 1 in N with a xorshift generator per thread.
+     * @param _rate   Sampling rate N.
+     * @return True, if the record is sampled.
+     */
+    bool sampled( std::uint32_t _rate ) noexcept {
+
+      /* Constant initialized, so there is no guard, seeded on first use. */
+      thread_local std::uint64_t state = 0;
+      if ( state == 0 ) {
+
+        const auto seed = static_cast<std::uint64_t>( std::chrono::steady_clock::now().time_since_epoch().count() ) ^ reinterpret_cast<std::uintptr_t>( &state );
+        state = seed | 1;
+      }
+      state ^= state >> 12;
+      state ^= state << 25;
+      state ^= state >> 27;
+      constexpr std::uint64_t multiplier = 0x2545F4914F6CDD1D;
+      return ( ( state * multiplier ) >> 32 ) % _rate == 0;
+    }
+
+    /**
+     * @brief Stream without buffer for records, that are not written.
+     * @return Stream without buffer.
+     */
+    std::ostream &nullStream() noexcept {
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+      thread_local std::ostream stream { nullptr };
+      return stream;
+#ifdef __clang__
+  #pragma clang diagnostic pop
 #endif
+    }
+  }
+
+  Configuration::Configuration() noexcept {
+
+    publish( m_settings );
+  }
+
+  std::string Configuration::filename() const {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    return m_filename;
+  }
+
+  void Configuration::setFilename( std::string_view _filename ) {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    m_filename = _filename;
+    const std::string &filename = m_filename;
+
+    SinkRegistry &sinks = SinkRegistry::instance();
+    if ( filename.empty() ) {
+
+      sinks.add( sinks.console() );
+      if ( m_fileSink ) {
+
+        sinks.remove( m_fileSink );
+      }
+      return;
+    }
+
+    if ( !m_fileSink ) {
+
+      m_fileSink = std::make_shared<FileSink>();
+    }
+    if ( !m_fileSink->open( filename ) ) {
+
+      logError() << "Cannot open log file" << filename;
+      return;
+    }
+    sinks.add( m_fileSink );
+    sinks.remove( sinks.console() );
+  }
+
+  void Configuration::setFlightRecorder( bool _flightRecorder ) {
+
+    update( [ _flightRecorder ]( Settings &_settings ) noexcept { _settings.flightRecorder = _flightRecorder; } );
+  }
+
+  void Configuration::setAsync( bool _async ) {
+
+    update( [ _async ]( Settings &_settings ) noexcept { _settings.async = _async; } );
+  }
+
+  void Configuration::apply( const Settings &_settings ) {
+
+    if ( _settings.flightRecorder && !m_settings.flightRecorder ) {
+
+      FlightRecorder::instance().installHandlers();
+    }
+    else if ( !_settings.flightRecorder && m_settings.flightRecorder ) {
+
+      FlightRecorder::uninstallHandlers();
+    }
+    if ( m_settings.async && !_settings.async && AsyncWriter::available() ) {
+
+      /* Keep the order of records, that are still pending. */
+      AsyncWriter::instance().flush();
+    }
+    const bool inherited = _settings.avoidLogBelow != m_settings.avoidLogBelow || _settings.flightRecorder != m_settings.flightRecorder;
+    m_settings = _settings;
+    publish( m_settings );
+    if ( inherited ) {
+
+      /* Categories resolve avoidLogBelow and the flight recorder into their own levels. */
+      Categories::instance().refresh();
+    }
+  }
+
+  void Configuration::publish( const Settings &_settings ) noexcept {
+
+    /* The inactive slot is rewritten, readers of the active slot are not disturbed. */
+    std::array<std::uint64_t, settingsWords> words {};
+    std::memcpy( words.data(), &_settings, sizeof( Settings ) );
+    const std::size_t inactive = 1 - m_active.load( std::memory_order_relaxed );
+    Slot &slot = m_slots[ inactive ];
+    const std::uint64_t sequence = slot.sequence.load( std::memory_order_relaxed );
+    slot.sequence.store( sequence + 1, std::memory_order_relaxed );
+    for ( std::size_t pos = 0; pos < settingsWords; pos++ ) {
+
+      /* Whoever sees a new word, sees the odd sequence as well. */
+      slot.words[ pos ].store( words[ pos ], std::memory_order_release );
+    }
+    slot.sequence.store( sequence + 2, std::memory_order_release );
+    m_active.store( inactive, std::memory_order_release );
+    m_threshold.store( _settings.flightRecorder ? Severity::Verbose : _settings.avoidLogBelow, std::memory_order_relaxed );
+  }
+
+  Logger::Logger( Severity _severity,
+                  const std::source_location &_location )
+    : Logger( _severity, _location, Configuration::instance().settings(), nullptr ) {}
 
   Logger::Logger( Severity _severity,
+                  const Category &_category,
                   const std::source_location &_location )
+    : Logger( _severity, _location, Configuration::instance().settings(), &_category ) {
+
+    if ( m_record != nullptr ) {
+
+      /* Part of the header, sinks with structured output get the category as own field. */
+      std::string &record = m_record->data();
+      record += '[';
+      record += _category.name();
+      record += ']';
+      record += ' ';
+      m_headerSize = record.size();
+      m_category = _category.name();
+    }
+  }
+
+  Logger::Logger( Severity _severity,
+                  const std::source_location &_location,
+                  const Settings &_settings,
+                  const Category *_category )
+    : Logger( _severity, _location, _settings, admit( _severity, _settings, _category ) ) {}
+
+  Logger::Admission Logger::admit( Severity _severity,
+                                  const Settings &_settings,
+                                  const Category *_category ) noexcept {
+
+    if ( _severity < minimumSeverity ) {
+
+      return { false, false, 0 };
+    }
+    const bool write = _severity >= ( _category != nullptr ? _category->level() : _settings.avoidLogBelow );
+    const bool formatted = write || _settings.flightRecorder;
+    const std::uint32_t sampleRate = _category != nullptr ? _category->sampling( _severity, _settings ) : _settings.sampling[ static_cast<std::size_t>( _severity ) ];
+    if ( !write || sampleRate <= 1 || _severity >= Severity::Error ) {
+
+      return { write, formatted, 0 };
+    }
+    if ( sampled( sampleRate ) ) {
+
+      return { true, true, sampleRate };
+    }
+
+    /* Not written, but still captured by the flight recorder. */
+    return { false, _settings.flightRecorder, 0 };
+  }
+
+  Logger::Logger( Severity _severity,
+                  const std::source_location &_location,
+                  const Settings &_settings,
+                  const Admission &_admission )
     : m_severity( _severity ),
       m_location( _location ),
-#ifdef _WIN32
-      m_stream( new WindowsBuffer() ) {
-#else
-      m_stream( {} ) {
-#endif
+      m_sampleRate( _admission.sampleRate ),
+      m_stream( _admission.formatted ? acquire() : nullStream() ) {
 
-    if ( Configuration::instance().avoidLogBelow() > _severity ) {
+    if ( m_record == nullptr ) {
 
       return;
     }
 
-    if ( _severity >= Severity::Error ) {
+    /* Everything later in the record is decided by this one copy of the settings. */
+    m_write = _admission.write;
+    m_recorded = _settings.flightRecorder;
+    m_async = _settings.async && AsyncWriter::available();
+    m_overflow = _settings.overflow;
+    m_autoSpace = _settings.autoSpace;
+    m_autoQuotes = _settings.autoQuotes;
+    m_maxElements = _settings.maxElements;
+    m_maxRecordSize = _settings.maxRecordSize;
+    printHeader( std::chrono::system_clock::now() );
+  }
+
+  Logger::Logger( Severity _severity,
+                  const std::source_location &_location,
+                  const std::chrono::system_clock::time_point &_timePoint,
+                  std::ostream &_output )
+    : m_severity( _severity ),
+      m_location( _location ),
+      m_output( _output.rdbuf() ),
+      m_stream( acquire() ) {
 
-      m_stream.rdbuf( std::cerr.rdbuf() );
-    }
-    else {
+    printHeader( _timePoint );
+  }
+
+  Logger::~Logger() noexcept {
 
-      m_stream.rdbuf( std::cout.rdbuf() );
+    if ( m_record == nullptr ) {
+
+      return;
     }
-    m_stream << timestamp() << ' ';
-    m_stream << severity( m_severity ) << ' ';
-    if ( _location.file_name() != "unsupported" ) {
 
-#ifdef _WIN32
-      constexpr char delimiter = '\\';
-#else
-      constexpr char delimiter = '/';
-#endif
-      std::string filename { _location.file_name() };
-      if ( m_locationPath == Path::Filename && filename.find_last_of( delimiter ) != std::string::npos ) {
+    try {
+
+      std::string &record = m_record->data();
+      record += '\n';
+      if ( m_recorded ) {
+
+        FlightRecorder::instance().record( record );
+      }
+
+      const Entry entry { m_severity, m_time, m_location.file_name(), m_location.line(), m_location.function_name(), record, m_headerSize, m_record->fields(), m_category };
+      if ( m_write && m_async ) {
 
-        const std::size_t pos = filename.find_last_of( delimiter );
-        filename = filename.substr( pos + 1, filename.size() - ( pos + 1 ) );
+        AsyncWriter::instance().push( Record( entry ), m_overflow );
+      }
+      else if ( m_write && m_output == nullptr && SinkRegistry::available() ) {
+
+        /* Formatted once, every sink gets the same record. */
+        SinkRegistry::instance().write( entry );
+      }
+      else if ( m_write && m_output == nullptr ) {
+
+        writeConsole( m_severity, record );
+      }
+      else if ( m_write ) {
+
+        m_output->sputn( record.data(), static_cast<std::streamsize>( record.size() ) );
+        m_output->pubsync();
+      }
+
+      if ( m_recorded && m_severity == Severity::Fatal ) {
+
+        /* Context of the incident, including the records below avoidLogBelow. */
+        FlightRecorder::instance().dump();
       }
-      m_stream << filename << ':' << _location.line() << ' ' << _location.function_name() << ' ';
     }
+    catch ( const std::bad_alloc & ) {
+
+      /* Nothing to do here, the record is lost. */
+    }
+    m_record->release();
   }
 
-  Logger::~Logger() noexcept {
+  bool Logger::emitted() const noexcept {
+
+    /* Records only formatted for the flight recorder are not written. */
+    return m_record != nullptr && m_write && ( !m_async || AsyncWriter::instance().accepts( m_severity, m_overflow ) );
+  }
+
+  std::string *Logger::text() noexcept {
+
+    return m_record != nullptr ? &m_record->data() : nullptr;
+  }
+
+  std::string *Logger::fields() noexcept {
+
+    return m_record != nullptr ? &m_record->fields() : nullptr;
+  }
+
+  std::ostream &Logger::acquire() {
+
+    if ( RecordBuffer &record = threadRecord(); !record.inUse() ) {
+
+      m_record = &record;
+    }
+    else {
 
-    m_stream << '\n';
-    m_stream.flush();
+      /* Logging while formatting another record of this thread. */
+      m_ownRecord = std::make_unique<RecordBuffer>();
+      m_record = m_ownRecord.get();
+    }
+    return m_record->acquire();
   }
 
   void Logger::printChar( std::int8_t _input ) noexcept {
@@ -115,6 +563,22 @@ namespace vx::logger {
     m_autoQuotes ? m_stream << std::quoted( _input ) : m_stream << _input;
   }
 
+  void Logger::printFloat( float _input ) noexcept {
+
+    if ( std::string *record = text(); record != nullptr ) {
+
+      appendFloat( *record, _input );
+    }
+  }
+
+  void Logger::printFloat( double _input ) noexcept {
+
+    if ( std::string *record = text(); record != nullptr ) {
+
+      appendFloat( *record, _input );
+    }
+  }
+
   Logger &Logger::operator<<( std::time_t _input ) noexcept {
 
     struct std::tm currentLocalTime {};
@@ -129,37 +593,71 @@ namespace vx::logger {
     return maybeSpace();
   }
 
-  std::string Logger::timestamp() const noexcept {
+  void Logger::printHeader( const std::chrono::system_clock::time_point &_timePoint ) {
 
-    return timestamp::iso8601( Precision::MicroSeconds );
-  }
+    m_time = _timePoint;
+    std::streambuf &output = *m_stream.rdbuf();
+    const auto append = [ &output ]( std::string_view _text ) {
+
+      output.sputn( _text.data(), static_cast<std::streamsize>( _text.size() ) );
+    };
+
+    timestamp::Iso8601Buffer timestamp {};
+    append( timestamp::iso8601( _timePoint, Precision::MicroSeconds, timestamp ) );
+    output.sputc( ' ' );
+    append( severity( m_severity ) );
+    output.sputc( ' ' );
+    if ( m_location.file_name() != "unsupported" ) {
+
+      std::string_view filename = m_location.file_name();
+      if ( m_locationPath == Path::Filename ) {
+
+        filename.remove_prefix( filenameOffset( filename ) );
+      }
+      append( filename );
+      output.sputc( ':' );
 
-  std::string Logger::severity( Severity _severity ) const {
+      std::array<char, std::numeric_limits<std::uint_least32_t>::digits10 + 1> line {};
+      const auto result = std::to_chars( line.data(), line.data() + line.size(), m_location.line() );
+      append( { line.data(), static_cast<std::size_t>( result.ptr - line.data() ) } );
+      output.sputc( ' ' );
+      append( m_location.function_name() );
+      output.sputc( ' ' );
+    }
+    if ( const Context *context = Context::current(); context != nullptr && m_output == nullptr ) {
 
-    std::string result {};
-    std::string severity( magic_enum::enum_name( _severity ) );
-    string_utils::toUpper( severity );
-    switch ( _severity ) {
+      std::string &text = m_record->data();
+      text += '[';
+      appendContext( *context, text, m_record->fields() );
+      text += ']';
+      text += ' ';
+    }
+    if ( m_sampleRate > 1 ) {
 
-      case Severity::Verbose:
-        result += "\x1b[37;1m[" + severity + "]\x1b[0m";
-        break;
-      case Severity::Debug:
-        result += "  \x1b[34;1m[" + severity + "]\x1b[0m";
-        break;
-      case Severity::Info:
-        result += "   \x1b[32;1m[" + severity + "]\x1b[0m";
-        break;
-      case Severity::Warning:
-        result += "\x1b[33;1m[" + severity + "]\x1b[0m";
-        break;
-      case Severity::Error:
-        result += "  \x1b[31;1m[" + severity + "]\x1b[0m";
-        break;
-      case Severity::Fatal:
-        result += "  \x1b[41;1m[" + severity + "]\x1b[0m";
-        break;
+      /* Marked, so the counts can be scaled up again. */
+      std::array<char, std::numeric_limits<std::uint32_t>::digits10 + 1> rate {};
+      const std::string_view digits( rate.data(), static_cast<std::size_t>( std::to_chars( rate.data(), rate.data() + rate.size(), m_sampleRate ).ptr - rate.data() ) );
+      append( "[sampled 1/" );
+      append( digits );
+      append( "] " );
+      m_record->fields() += ",\"sampleRate\":";
+      m_record->fields() += digits;
     }
-    return result;
+    m_headerSize = m_record->data().size();
+  }
+
+  std::string_view Logger::severity( Severity _severity ) noexcept {
+
+    /* Padded to the same width, colored and in the order of Severity. */
+    constexpr std::array<std::string_view, 6> severities {
+
+      "\x1b[37;1m[VERBOSE]\x1b[0m",
+      "  \x1b[34;1m[DEBUG]\x1b[0m",
+      "   \x1b[32;1m[INFO]\x1b[0m",
+      "\x1b[33;1m[WARNING]\x1b[0m",
+      "  \x1b[31;1m[ERROR]\x1b[0m",
+      "  \x1b[41;1m[FATAL]\x1b[0m"
+    };
+    return severities[ static_cast<std::size_t>( _severity ) ];
   }
 }
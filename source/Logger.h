@@ -31,10 +31,19 @@
 #pragma once
 
 /* c header */
-#include <cstdint> // std::int8_t, std::int32_t
+#include <cstdint> // std::int8_t, std::int32_t, std::uint64_t, std::uintmax_t
+#include <cstring> // std::memcpy
 
 /* stl header */
+#include <array>
+#include <atomic>
+#include <charconv> // std::to_chars
 #include <chrono>
+#include <format>
+#include <iterator> // std::back_inserter
+#include <limits>
+#include <memory> // std::shared_ptr, std::unique_ptr
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <ratio>
@@ -42,11 +51,21 @@
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <type_traits> // std::integral_constant
+#include <utility> // std::forward
 #include <variant>
+#include <vector>
 
 /* local header */
 #include "Singleton.h"
 
+#ifndef CORE_LOG_MIN_SEVERITY
+  /**
+   * @brief Logging below this severity is removed at compile time.
+   */
+  #define CORE_LOG_MIN_SEVERITY Verbose
+#endif
+
 /**
  * @brief vx (VX APPS) logger namespace.
  */
@@ -65,6 +84,17 @@ namespace vx::logger {
     Fatal    /**< Fatal error level. */
   };
 
+  /**
+   * @brief The Overflow enum, what happens to a record, when the queue of the asynchronous writer is full.
+   */
+  enum class Overflow {
+
+    Block,         /**< Wait until the writer made room. */
+    DropNewest,    /**< Drop the new record. */
+    DropOldest,    /**< Drop the oldest queued record. */
+    DropBySeverity /**< Drop the new record, but wait for Error and Fatal. */
+  };
+
   /**
    * @brief The Flags enum.
    */
@@ -86,83 +116,473 @@ namespace vx::logger {
     Filename  /**< Only the filename. */
   };
 
+  /**
+   * @brief File output of the logger.
+   */
+  class FileSink;
+
+  /**
+   * @brief Named category with its own level.
+   */
+  class Category;
+
+  /**
+   * @brief Immutable snapshot of the logger configuration.
+   */
+  struct Settings {
+
+    /**
+     * @brief Automatically space the arguments of a record.
+     */
+    bool autoSpace = true;
+
+    /**
+     * @brief Automatically quote strings.
+     */
+    bool autoQuotes = true;
+
+    /**
+     * @brief Logging below this level will not written.
+     */
+    Severity avoidLogBelow = Severity::Warning;
+
+    /**
+     * @brief Hand over records to a background writer thread.
+     */
+    bool async = false;
+
+    /**
+     * @brief Policy, when the queue of the asynchronous writer is full.
+     */
+    Overflow overflow = Overflow::Block;
+
+    /**
+     * @brief Capture every record in a ring in memory.
+     */
+    bool flightRecorder = false;
+
+    /**
+     * @brief Size in bytes, when the file is rotated - 0 for no size limit.
+     */
+    std::uintmax_t maxFileSize = 0;
+
+    /**
+     * @brief Wall-clock interval, when the file is rotated - 0 for no interval.
+     */
+    std::chrono::seconds rotationInterval { 0 };
+
+    /**
+     * @brief Number of rotated files, that are kept as filename.1 up to filename.N.
+     */
+    std::size_t maxFiles = 5;
+
+    /**
+     * @brief Number of elements, that are written for a container or range - 0 for no limit.
+     */
+    std::size_t maxElements = 256;
+
+    /**
+     * @brief Size in bytes, after that no further container elements are written - 0 for no limit.
+     */
+    std::size_t maxRecordSize = 64 * 1024;
+
+    /**
+     * @brief Write 1 in N records per severity, chosen at random - 0 and 1 write every record, Error and Fatal are never sampled.
+     */
+    std::array<std::uint32_t, static_cast<std::size_t>( Severity::Fatal ) + 1> sampling {};
+  };
+
   /**
    * @brief Logger configuration.
+   * Settings are published as a whole into one of two slots, each guarded by a sequence lock, so logging threads copy them without lock while they are reconfigured.
    * @author Florian Becker <fb\@vxapps.com> (VX APPS)
    */
   class Configuration : public Singleton<Configuration> {
 
   public:
+    /**
+     * @brief Default constructor for Configuration.
+     */
+    Configuration() noexcept;
+
+    /**
+     * @brief Get current settings, a consistent copy without lock.
+     * @return Current settings.
+     */
+    [[nodiscard]] inline Settings settings() const noexcept {
+
+      std::array<std::uint64_t, settingsWords> words {};
+      while ( true ) {
+
+        const Slot &slot = m_slots[ m_active.load( std::memory_order_acquire ) ];
+        const std::uint64_t sequence = slot.sequence.load( std::memory_order_acquire );
+        for ( std::size_t pos = 0; pos < settingsWords; pos++ ) {
+
+          words[ pos ] = slot.words[ pos ].load( std::memory_order_acquire );
+        }
+
+        /* Retry, if the slot was rewritten meanwhile, it is only reused two changes later. */
+        if ( ( sequence & 1 ) == 0 && slot.sequence.load( std::memory_order_relaxed ) == sequence ) {
+
+          break;
+        }
+      }
+      Settings settings {};
+      std::memcpy( static_cast<void *>( &settings ), words.data(), sizeof( Settings ) );
+      return settings;
+    }
+
+    /**
+     * @brief Change several settings, that become visible together.
+     * Changes of async and flightRecorder are applied like with their setters.
+     * @param _change   Callable, that changes a copy of the current settings, e.g. []( Settings &_settings ) { ... }.
+     */
+    template <typename Change>
+    void update( Change _change ) {
+
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      Settings settings = m_settings;
+      _change( settings );
+      apply( settings );
+    }
+
     /**
      * @brief Get filename.
      * @return Filename.
      */
-    [[nodiscard]] inline std::string filename() const { return m_filename; }
+    [[nodiscard]] std::string filename() const;
+
+    /**
+     * @brief Set filename, records are written to this file instead of the console.
+     * @param _filename   The filename, empty to write to the console again.
+     * @note Further sinks with own thresholds are added with SinkRegistry.
+     */
+    void setFilename( std::string_view _filename );
+
+    /**
+     * @brief Get maximum file size.
+     * @return Size in bytes, when the file is rotated - 0 for no size limit.
+     */
+    [[nodiscard]] inline std::uintmax_t maxFileSize() const noexcept { return settings().maxFileSize; }
 
     /**
-     * @brief Set filename.
-     * @param _filename   The filename.
+     * @brief Set maximum file size.
+     * @param _maxFileSize   Size in bytes, when the file is rotated - 0 for no size limit.
      */
-    void setFilename( std::string_view _filename ) { m_filename = _filename; }
+    inline void setMaxFileSize( std::uintmax_t _maxFileSize ) {
+
+      update( [ _maxFileSize ]( Settings &_settings ) noexcept { _settings.maxFileSize = _maxFileSize; } );
+    }
+
+    /**
+     * @brief Get rotation interval.
+     * @return Wall-clock interval, when the file is rotated - 0 for no interval.
+     */
+    [[nodiscard]] inline std::chrono::seconds rotationInterval() const noexcept { return settings().rotationInterval; }
+
+    /**
+     * @brief Set rotation interval, e.g. std::chrono::hours( 24 ) rotates at midnight UTC.
+     * @param _rotationInterval   Wall-clock interval, when the file is rotated - 0 for no interval.
+     */
+    inline void setRotationInterval( std::chrono::seconds _rotationInterval ) {
+
+      update( [ _rotationInterval ]( Settings &_settings ) noexcept { _settings.rotationInterval = _rotationInterval; } );
+    }
+
+    /**
+     * @brief Get maximum number of retained files.
+     * @return Number of rotated files, that are kept as filename.1 up to filename.N.
+     */
+    [[nodiscard]] inline std::size_t maxFiles() const noexcept { return settings().maxFiles; }
+
+    /**
+     * @brief Set maximum number of retained files.
+     * @param _maxFiles   Number of rotated files, that are kept as filename.1 up to filename.N.
+     */
+    inline void setMaxFiles( std::size_t _maxFiles ) {
+
+      update( [ _maxFiles ]( Settings &_settings ) noexcept { _settings.maxFiles = _maxFiles; } );
+    }
+
+    /**
+     * @brief Get maximum number of elements per container.
+     * @return Number of elements, that are written for a container or range - 0 for no limit.
+     */
+    [[nodiscard]] inline std::size_t maxElements() const noexcept { return settings().maxElements; }
+
+    /**
+     * @brief Set maximum number of elements per container, further elements are elided as "... N more".
+     * @param _maxElements   Number of elements, that are written for a container or range - 0 for no limit.
+     */
+    inline void setMaxElements( std::size_t _maxElements ) {
+
+      update( [ _maxElements ]( Settings &_settings ) noexcept { _settings.maxElements = _maxElements; } );
+    }
+
+    /**
+     * @brief Get maximum record size.
+     * @return Size in bytes, after that no further container elements are written - 0 for no limit.
+     */
+    [[nodiscard]] inline std::size_t maxRecordSize() const noexcept { return settings().maxRecordSize; }
+
+    /**
+     * @brief Set maximum record size, further container elements are elided as "... N more".
+     * @param _maxRecordSize   Size in bytes, after that no further container elements are written - 0 for no limit.
+     */
+    inline void setMaxRecordSize( std::size_t _maxRecordSize ) {
+
+      update( [ _maxRecordSize ]( Settings &_settings ) noexcept { _settings.maxRecordSize = _maxRecordSize; } );
+    }
+
+    /**
+     * @brief Get sampling rate of a severity.
+     * @param _severity   Severity of the records.
+     * @return Write 1 in N records - 0 and 1 write every record.
+     */
+    [[nodiscard]] inline std::uint32_t sampling( Severity _severity ) const noexcept { return settings().sampling[ static_cast<std::size_t>( _severity ) ]; }
+
+    /**
+     * @brief Set sampling rate of a severity, written records are marked with the rate, e.g. [sampled 1/1000].
+     * @param _severity   Severity of the records, Error and Fatal are never sampled.
+     * @param _rate   Write 1 in N records, chosen at random - 0 and 1 write every record.
+     */
+    inline void setSampling( Severity _severity,
+                             std::uint32_t _rate ) {
+
+      update( [ _severity, _rate ]( Settings &_settings ) noexcept { _settings.sampling[ static_cast<std::size_t>( _severity ) ] = _rate; } );
+    }
 
     /**
      * @brief Is auto space enabled?
      * @return True, if auto space is enabled - otherwise false.
      */
-    [[nodiscard]] inline bool autoSpace() const noexcept { return m_autoSpace; }
+    [[nodiscard]] inline bool autoSpace() const noexcept { return settings().autoSpace; }
 
     /**
      * @brief Set auto space.
      * @param _autoSpace   True, to enable auto space.
      */
-    inline void setAutoSpace( bool _autoSpace ) noexcept { m_autoSpace = _autoSpace; }
+    inline void setAutoSpace( bool _autoSpace ) {
+
+      update( [ _autoSpace ]( Settings &_settings ) noexcept { _settings.autoSpace = _autoSpace; } );
+    }
 
     /**
      * @brief Is auto quotes enabled?
      * @return True, auto quotes are enabled - otherwise false.
      */
-    [[nodiscard]] inline bool autoQuotes() const noexcept { return m_autoQuotes; }
+    [[nodiscard]] inline bool autoQuotes() const noexcept { return settings().autoQuotes; }
 
     /**
      * @brief Set auto quotes.
      * @param _autoQuotes   True, to enable auto quotes.
      */
-    inline void setAutoQuotes( bool _autoQuotes ) noexcept { m_autoQuotes = _autoQuotes; }
+    inline void setAutoQuotes( bool _autoQuotes ) {
+
+      update( [ _autoQuotes ]( Settings &_settings ) noexcept { _settings.autoQuotes = _autoQuotes; } );
+    }
 
     /**
      * @brief Avoid log below loglevel.
      * @return Current loglevel.
      */
-    [[nodiscard]] inline Severity avoidLogBelow() const noexcept { return m_avoidLogBelow; }
+    [[nodiscard]] inline Severity avoidLogBelow() const noexcept { return settings().avoidLogBelow; }
 
     /**
      * @brief Set avoid log below.
      * @param _severity   Logging below this level will not written.
      */
-    inline void setAvoidLogBelow( Severity _severity ) noexcept { m_avoidLogBelow = _severity; }
+    inline void setAvoidLogBelow( Severity _severity ) {
+
+      update( [ _severity ]( Settings &_settings ) noexcept { _settings.avoidLogBelow = _severity; } );
+    }
+
+    /**
+     * @brief Is asynchronous logging enabled?
+     * @return True, if records are written by a background thread - otherwise false.
+     */
+    [[nodiscard]] inline bool async() const noexcept { return settings().async; }
+
+    /**
+     * @brief Set asynchronous logging.
+     * @param _async   True, to hand over records to a background writer thread.
+     */
+    void setAsync( bool _async );
+
+    /**
+     * @brief Get overflow policy.
+     * @return Policy, when the queue of the asynchronous writer is full.
+     */
+    [[nodiscard]] inline Overflow overflow() const noexcept { return settings().overflow; }
+
+    /**
+     * @brief Set overflow policy, dropped records are counted per severity and summarized in the log.
+     * @param _overflow   Policy, when the queue of the asynchronous writer is full.
+     */
+    inline void setOverflow( Overflow _overflow ) {
+
+      update( [ _overflow ]( Settings &_settings ) noexcept { _settings.overflow = _overflow; } );
+    }
+
+    /**
+     * @brief Is the flight recorder enabled?
+     * @return True, if every record is captured in memory - otherwise false.
+     */
+    [[nodiscard]] inline bool flightRecorder() const noexcept { return settings().flightRecorder; }
+
+    /**
+     * @brief Set flight recorder, captures every record, also below avoidLogBelow, in a ring in memory.
+     * The last records are dumped to stderr on logFatal(), SIGSEGV and SIGABRT.
+     * @param _flightRecorder   True, to enable the flight recorder.
+     */
+    void setFlightRecorder( bool _flightRecorder );
+
+    /**
+     * @brief Get lowest severity, that is formatted to be written or to be captured by the flight recorder, a single atomic load.
+     * @return Logging below this severity is not formatted.
+     */
+    [[nodiscard]] inline Severity threshold() const noexcept { return m_threshold.load( std::memory_order_relaxed ); }
 
   private:
+    static_assert( std::is_trivially_copyable_v<Settings>, "settings are copied word by word" );
+
     /**
-     * @brief Member for auto space.
+     * @brief Number of words of the settings.
      */
-    bool m_autoSpace = true;
+    static constexpr std::size_t settingsWords = ( sizeof( Settings ) + sizeof( std::uint64_t ) - 1 ) / sizeof( std::uint64_t );
 
     /**
-     * @brief Member for auto quotes.
+     * @brief Published settings, guarded by a sequence lock.
      */
-    bool m_autoQuotes = true;
+    struct Slot {
+
+      /**
+       * @brief Odd while the slot is written.
+       */
+      std::atomic<std::uint64_t> sequence { 0 };
+
+      /**
+       * @brief Settings word by word.
+       */
+      std::array<std::atomic<std::uint64_t>, settingsWords> words {};
+    };
+
+    /**
+     * @brief Apply side effects of changed settings and publish them, the mutex is locked.
+     * @param _settings   New settings.
+     */
+    void apply( const Settings &_settings );
+
+    /**
+     * @brief Publish settings into the inactive slot and activate it, the mutex is locked.
+     * @param _settings   New settings.
+     */
+    void publish( const Settings &_settings ) noexcept;
 
     /**
-     * @brief Member for avoid log level.
+     * @brief Member for mutex to serialize changes.
      */
-    Severity m_avoidLogBelow = Severity::Warning;
+    mutable std::mutex m_mutex {};
 
     /**
-     * @brief Member for filename.
+     * @brief Member for current settings of the writers, guarded by the mutex.
+     */
+    Settings m_settings {};
+
+    /**
+     * @brief Member for filename, guarded by the mutex.
      */
     std::string m_filename {};
+
+    /**
+     * @brief Member for slots of the published settings.
+     */
+    std::array<Slot, 2> m_slots {};
+
+    /**
+     * @brief Member for index of the active slot.
+     */
+    std::atomic<std::size_t> m_active { 0 };
+
+    /**
+     * @brief Member for lowest formatted severity of the published settings.
+     */
+    std::atomic<Severity> m_threshold { Severity::Verbose };
+
+    /**
+     * @brief Member for file sink of the filename.
+     */
+    std::shared_ptr<FileSink> m_fileSink {};
+  };
+
+  /**
+   * @brief Minimum severity compiled into the binary.
+   */
+  constexpr Severity minimumSeverity = Severity::CORE_LOG_MIN_SEVERITY;
+
+  /**
+   * @brief Will a record of this severity be written?
+   * @param _severity   Severity to check.
+   * @return True, if the severity passes the compile time and the configured limit - otherwise false.
+   */
+  [[nodiscard]] inline bool enabled( Severity _severity ) noexcept {
+
+    /* Checked first, so records below the minimum never touch the configuration. */
+    if ( _severity < minimumSeverity ) {
+
+      return false;
+    }
+    return _severity >= Configuration::instance().avoidLogBelow();
+  }
+
+  /**
+   * @brief Will a record of this severity be formatted, either to be written or to be captured by the flight recorder?
+   * @param _severity   Severity to check.
+   * @return True, if the severity passes the compile time limit and is written or captured - otherwise false.
+   */
+  [[nodiscard]] inline bool formatted( Severity _severity ) noexcept {
+
+    if ( _severity < minimumSeverity ) {
+
+      return false;
+    }
+    return _severity >= Configuration::instance().threshold();
+  }
+
+  /**
+   * @brief Offset of the filename in a path.
+   * @param _path   Path of a source file.
+   * @return Position after the last delimiter or 0.
+   */
+  [[nodiscard]] constexpr std::size_t filenameOffset( std::string_view _path ) noexcept {
+
+#ifdef _WIN32
+    constexpr char delimiter = '\\';
+#else
+    constexpr char delimiter = '/';
+#endif
+    const std::size_t position = _path.find_last_of( delimiter );
+    return position == std::string_view::npos ? 0 : position + 1;
+  }
+
+  /**
+   * @brief Turns a logging expression into void, so it can be used in a conditional expression.
+   */
+  struct Voidify {
+
+    /**
+     * @brief Swallow the logging expression.
+     * @tparam T   Type of the logging expression.
+     */
+    template <typename T>
+    constexpr void operator&( [[maybe_unused]] T &&_expression ) const noexcept { /* empty */ }
   };
 
+  /**
+   * @brief Reusable buffer of a record.
+   */
+  class RecordBuffer;
+
   /**
    * @brief Logger class.
    * @author Florian Becker <fb\@vxapps.com> (VX APPS)
@@ -178,6 +598,28 @@ namespace vx::logger {
     explicit Logger( Severity _severity = Severity::Debug,
                      const std::source_location &_location = std::source_location::current() );
 
+    /**
+     * @brief Constructor for Logger with a category, that is checked against the level of the category.
+     * @param _severity   Severity type.
+     * @param _category   Category of the record.
+     * @param _location   Source location informations.
+     */
+    Logger( Severity _severity,
+            const Category &_category,
+            const std::source_location &_location = std::source_location::current() );
+
+    /**
+     * @brief Constructor for Logger to replay a record, e.g. from a binary log.
+     * @param _severity   Severity type.
+     * @param _location   Source location informations.
+     * @param _timePoint   Point in time, when the record was created.
+     * @param _output   Stream to write the record to.
+     */
+    Logger( Severity _severity,
+            const std::source_location &_location,
+            const std::chrono::system_clock::time_point &_timePoint,
+            std::ostream &_output );
+
     /**
      * @brief Default destructor for Logger.
      */
@@ -211,6 +653,57 @@ namespace vx::logger {
      */
     Logger &logger() noexcept { return *this; }
 
+    /**
+     * @brief Will the record be written?
+     * @return True, if the record passes avoidLogBelow and is not going to be dropped by the asynchronous writer - otherwise false.
+     */
+    [[nodiscard]] bool emitted() const noexcept;
+
+    /**
+     * @brief Text of the record.
+     * @return Text of the record or nullptr, if the record is not formatted.
+     */
+    [[nodiscard]] std::string *text() noexcept;
+
+    /**
+     * @brief Structured fields of the record as JSON members, e.g. ,"user":42.
+     * @return Fields of the record or nullptr, if the record is not formatted.
+     */
+    [[nodiscard]] std::string *fields() noexcept;
+
+    /**
+     * @brief Format the arguments directly into the record, the format string is checked at compile time.
+     * @tparam Args   Types of the arguments.
+     * @param _format   Format string, e.g. "{} took {}".
+     * @param _args   Arguments for the format string.
+     * @return Logger with output.
+     */
+    template <typename... Args>
+    Logger &logger( std::format_string<Args...> _format,
+                    Args &&..._args ) {
+
+      if ( std::string *record = text(); record != nullptr ) {
+
+        std::format_to( std::back_inserter( *record ), _format, std::forward<Args>( _args )... );
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Are the limits for container output reached?
+     * @param _elements   Number of elements of the current container, that are already written.
+     * @return True, if the record is not formatted, the next element exceeds maxElements or the record exceeds maxRecordSize - otherwise false.
+     */
+    [[nodiscard]] bool exhausted( std::size_t _elements ) noexcept {
+
+      const std::string *record = text();
+      if ( record == nullptr || ( m_maxElements > 0 && _elements >= m_maxElements ) ) {
+
+        return true;
+      }
+      return m_maxRecordSize > 0 && record->size() >= m_maxRecordSize;
+    }
+
     /**
      * @brief Print char.
      * @param _input   Char.
@@ -223,6 +716,34 @@ namespace vx::logger {
      */
     void printString( std::string_view _input );
 
+    /**
+     * @brief Print an integer with std::to_chars directly into the record, independent of the locale.
+     * @tparam T   Integer type.
+     * @param _input   Integer.
+     */
+    template <typename T>
+    inline void printInteger( T _input ) noexcept {
+
+      if ( std::string *record = text(); record != nullptr ) {
+
+        std::array<char, std::numeric_limits<T>::digits10 + 2> buffer {};
+        const std::to_chars_result result = std::to_chars( buffer.data(), buffer.data() + buffer.size(), _input );
+        record->append( buffer.data(), result.ptr );
+      }
+    }
+
+    /**
+     * @brief Print float with the shortest digits, that read back to the same value.
+     * @param _input   Float.
+     */
+    void printFloat( float _input ) noexcept;
+
+    /**
+     * @brief Print double with the shortest digits, that read back to the same value.
+     * @param _input   Double.
+     */
+    void printFloat( double _input ) noexcept;
+
     /**
      * @brief Is auto space enabled?
      * @return True, if auto space is enabled - otherwise false.
@@ -318,7 +839,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( std::int32_t _input ) noexcept {
 
-      m_stream << _input;
+      printInteger( _input );
       return maybeSpace();
     }
 
@@ -330,7 +851,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( std::uint32_t _input ) noexcept {
 
-      m_stream << _input;
+      printInteger( _input );
       return maybeSpace();
     }
 #endif
@@ -345,7 +866,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( std::size_t _input ) noexcept {
 
-      m_stream << _input;
+      printInteger( _input );
       return maybeSpace();
     }
 #endif
@@ -358,7 +879,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( std::int64_t _input ) noexcept {
 
-      m_stream << _input;
+      printInteger( _input );
       return maybeSpace();
     }
 
@@ -369,7 +890,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( std::uint64_t _input ) noexcept {
 
-      m_stream << _input;
+      printInteger( _input );
       return maybeSpace();
     }
 #endif
@@ -381,10 +902,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( float _input ) noexcept {
 
-      const std::streamsize saveState = m_stream.precision();
-      m_stream.precision( std::numeric_limits<float>::max_digits10 );
-      m_stream << _input;
-      m_stream.precision( saveState );
+      printFloat( _input );
       return maybeSpace();
     }
 
@@ -395,10 +913,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( double _input ) noexcept {
 
-      const std::streamsize saveState = m_stream.precision();
-      m_stream.precision( std::numeric_limits<double>::max_digits10 );
-      m_stream << _input;
-      m_stream.precision( saveState );
+      printFloat( _input );
       return maybeSpace();
     }
 
@@ -502,155 +1017,187 @@ namespace vx::logger {
       return maybeSpace();
     }
 
+  private:
     /**
-     * @brief Internal print std::tuple.
-     * @param _current   Current tuple position.
-     * @param _tuple   Tuple type input.
-     * @param _size   Tuple size.
+     * @brief Automatically sapce next argument.
      */
-    template <typename Tuple>
-    void printTupleReal( [[maybe_unused]] std::size_t _current,
-                         [[maybe_unused]] const Tuple &_tuple,
-                         [[maybe_unused]] typename std::tuple_size<Tuple>::type _size ) const noexcept { /* empty */ }
+    bool m_autoSpace = true;
 
     /**
-     * @brief Internal print std::tuple.
-     * @param _current   Current tuple position.
-     * @param _tuple   Tuple type input.
-     * @param _integral   Integral position to access it directly.
+     * @brief Automatically quote strings.
      */
-    template <std::size_t _pos, typename Tuple, typename = std::enable_if_t<std::tuple_size<Tuple>::value != _pos>>
-    void printTupleReal( std::size_t _current,
-                         const Tuple &_tuple,
-                         [[maybe_unused]] std::integral_constant<std::size_t, _pos> _integral ) noexcept {
+    bool m_autoQuotes = true;
 
-      if ( _current == _pos ) {
+    /**
+     * @brief Hand over the record to the background writer.
+     */
+    bool m_async = false;
 
-        const bool saveState = autoSpace();
-        nospace() << std::get<_pos>( _tuple );
-        setAutoSpace( saveState );
-      }
-      else {
+    /**
+     * @brief Write the record, false if it is only captured by the flight recorder.
+     */
+    bool m_write = true;
 
-        printTupleReal( _current, _tuple, std::integral_constant<std::size_t, _pos + 1>() );
-      }
-    }
+    /**
+     * @brief Capture the record by the flight recorder.
+     */
+    bool m_recorded = false;
 
     /**
-     * @brief Output std::tuple.
-     * @param _pos   Starting tuple  position.
-     * @param _tuple   Tuple type input.
+     * @brief Member for overflow policy of the asynchronous writer.
      */
-    template <typename Tuple>
-    void printTuple( std::size_t _pos,
-                     const Tuple &_tuple ) noexcept {
+    Overflow m_overflow = Overflow::Block;
 
-      printTupleReal( _pos, _tuple, std::integral_constant<std::size_t, 0>() );
-    }
+    /**
+     * @brief Member fpr severity.
+     */
+    Severity m_severity = Severity::Debug;
+
+    /**
+     * @brief Member for location path configuration.
+     */
+    Path m_locationPath = Path::Filename;
+
+    /**
+     * @brief Member for source location.
+     */
+    std::source_location m_location;
 
     /**
-     * @brief Internal print std::variant.
-     * @param _current   Current variant position.
-     * @param _variant   Variant type input.
-     * @param _size   Variant size.
+     * @brief Member for point in time, when the record was created.
      */
-    template <typename Variant>
-    void printVariantReal( [[maybe_unused]] std::size_t _current,
-                           [[maybe_unused]] const Variant &_variant,
-                           [[maybe_unused]] typename std::variant_size<Variant>::type _size ) const noexcept { /* empty */ }
+    std::chrono::system_clock::time_point m_time {};
 
     /**
-     * @brief Internal print std::variant.
-     * @param _current   Current variant position.
-     * @param _variant   Variant typeinput.
-     * @param _integral   Integral position to access it directly.
+     * @brief Member for size of the header at the beginning of the text.
      */
-    template <std::size_t _pos, typename Variant, typename = std::enable_if_t<std::variant_size<Variant>::value != _pos>>
-    void printVariantReal( std::size_t _current,
-                           const Variant &_variant,
-                           [[maybe_unused]] std::integral_constant<std::size_t, _pos> _integral ) noexcept {
+    std::size_t m_headerSize = 0;
 
-      if ( _current == _pos ) {
+    /**
+     * @brief Member for category of the record - empty without category.
+     */
+    std::string_view m_category {};
 
-        try {
+    /**
+     * @brief Member for sampling rate of a sampled record - otherwise 0.
+     */
+    std::uint32_t m_sampleRate = 0;
 
-          const bool saveState = autoSpace();
-          nospace() << std::get<_pos>( _variant );
-          setAutoSpace( saveState );
-        }
-        catch ( const std::bad_variant_access &_exception ) {
+    /**
+     * @brief Member for number of elements, that are written for a container or range - 0 for no limit.
+     */
+    std::size_t m_maxElements = 0;
 
-          /* Nothing to do here. */
-          stream() << "bad_variant_access " << _exception.what();
-        }
-      }
-      else {
+    /**
+     * @brief Member for size in bytes, after that no further container elements are written - 0 for no limit.
+     */
+    std::size_t m_maxRecordSize = 0;
 
-        printVariantReal( _current, _variant, std::integral_constant<std::size_t, _pos + 1>() );
-      }
-    }
+    /**
+     * @brief Member for output of a replayed record, nullptr for the console.
+     */
+    std::streambuf *m_output = nullptr;
 
     /**
-     * @brief Output std::variant.
-     * @param _pos   Starting variant position.
-     * @param _variant   Variant type input.
+     * @brief Member for record buffer, nullptr if the record is not written.
      */
-    template <typename Variant>
-    void printVariant( std::size_t _pos,
-                       const Variant &_variant ) noexcept {
+    RecordBuffer *m_record = nullptr;
 
-      printVariantReal( _pos, _variant, std::integral_constant<std::size_t, 0>() );
-    }
+    /**
+     * @brief Member for own record buffer, if the buffer of the thread is already in use.
+     */
+    std::unique_ptr<RecordBuffer> m_ownRecord {};
 
-  private:
     /**
-     * @brief Automatically sapce next argument.
+     * @brief Member for stream, appends into the record buffer.
      */
-    bool m_autoSpace = true;
+    std::ostream &m_stream;
 
     /**
-     * @brief Automatically quote strings.
+     * @brief Decision, if and how a record is written.
      */
-    bool m_autoQuotes = true;
+    struct Admission {
+
+      /**
+       * @brief True, if the record is written.
+       */
+      bool write;
+
+      /**
+       * @brief True, if the record is formatted, either to be written or to be captured.
+       */
+      bool formatted;
+
+      /**
+       * @brief Sampling rate of a written sampled record - otherwise 0.
+       */
+      std::uint32_t sampleRate;
+    };
 
     /**
-     * @brief Member fpr severity.
+     * @brief Check the thresholds and sample the record before anything is formatted.
+     * @param _severity   Severity type.
+     * @param _settings   Settings of the record.
+     * @param _category   Category of the record or nullptr.
+     * @return Decision for the record.
      */
-    Severity m_severity = Severity::Debug;
+    [[nodiscard]] static Admission admit( Severity _severity,
+                                          const Settings &_settings,
+                                          const Category *_category ) noexcept;
 
     /**
-     * @brief Member for location path configuration.
+     * @brief Constructor for Logger with the settings, that are read once per record.
+     * @param _severity   Severity type.
+     * @param _location   Source location informations.
+     * @param _settings   Settings of the record.
+     * @param _category   Category of the record or nullptr.
      */
-    Path m_locationPath = Path::Filename;
+    Logger( Severity _severity,
+            const std::source_location &_location,
+            const Settings &_settings,
+            const Category *_category );
 
     /**
-     * @brief Member for source location.
+     * @brief Constructor for Logger, the thresholds are already checked.
+     * @param _severity   Severity type.
+     * @param _location   Source location informations.
+     * @param _settings   Settings of the record.
+     * @param _admission   Decision, if and how the record is written.
      */
-    std::source_location m_location;
+    Logger( Severity _severity,
+            const std::source_location &_location,
+            const Settings &_settings,
+            const Admission &_admission );
 
     /**
-     * @brief Member for stream.
+     * @brief Acquire a record buffer, preferably the one of the current thread.
+     * @return Stream to format the record.
      */
-    std::ostream m_stream;
+    std::ostream &acquire();
 
     /**
-     * @brief Create timestamp.
-     * @return A timestamp.
+     * @brief Print timestamp, severity and source location.
+     * @param _timePoint   Point in time of the record.
      */
-    std::string timestamp() const noexcept;
+    void printHeader( const std::chrono::system_clock::time_point &_timePoint );
 
     /**
      * @brief Create severity output.
      * @param _severity   Which severity to generate?
      * @return The formatted severity.
      */
-    std::string severity( Severity _severity ) const;
+    static std::string_view severity( Severity _severity ) noexcept;
   };
 }
 
-#define logVerbose vx::logger::Logger( vx::logger::Severity::Verbose ).logger
-#define logDebug vx::logger::Logger( vx::logger::Severity::Debug ).logger
-#define logInfo vx::logger::Logger( vx::logger::Severity::Info ).logger
-#define logWarning vx::logger::Logger( vx::logger::Severity::Warning ).logger
-#define logError vx::logger::Logger( vx::logger::Severity::Error ).logger
-#define logFatal vx::logger::Logger( vx::logger::Severity::Fatal ).logger
+/* The filename of the source location is cut from the path at compile time. */
+#define logLocation() std::source_location::current( std::string_view( __FILE__ ).substr( std::integral_constant<std::size_t, vx::logger::filenameOffset( __FILE__ )>::value ) )
+
+/* The severity is checked before the logger is created and before any argument is evaluated, below the minimum it is a constant. */
+#define logSeverity( _severity ) ( _severity ) < vx::logger::minimumSeverity || !vx::logger::formatted( _severity ) ? static_cast<void>( 0 ) : vx::logger::Voidify() & vx::logger::Logger( _severity, logLocation() ).logger
+#define logVerbose logSeverity( vx::logger::Severity::Verbose )
+#define logDebug logSeverity( vx::logger::Severity::Debug )
+#define logInfo logSeverity( vx::logger::Severity::Info )
+#define logWarning logSeverity( vx::logger::Severity::Warning )
+#define logError logSeverity( vx::logger::Severity::Error )
+#define logFatal logSeverity( vx::logger::Severity::Fatal )
@@ -31,28 +31,26 @@
 #pragma once
 
 /* c header */
-#include <cstdint> // std::int8_t, std::int32_t
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int8_t, std::int32_t, std::uint32_t
 
 /* stl header */
 #include <any>
 #include <array>
-#include <functional>
+#include <atomic>
+#include <functional> // std::less
 #include <list>
-#include <map>
-#include <optional>
 #include <set>
 #include <string>
 #include <string_view>
-#include <tuple>
-#include <typeindex>
-#include <unordered_map>
-#include <utility> // std::pair
-#include <variant>
+#include <type_traits> // std::is_empty_v
+#include <typeinfo>
 #include <vector>
 
 /* local header */
 #include "Demangle.h"
 #include "Logger_container.h"
+#include "Singleton.h"
 
 /**
  * @brief vx (VX APPS) logger namespace.
@@ -60,76 +58,128 @@
 namespace vx::logger {
 
   /**
-   * @brief Add visitor.
-   * @param _function   Visitor function.
-   * @return Pair of type and possible visitor.
+   * @brief Visitor, that writes the value of a std::any holding a registered type.
    */
-  template <typename T, typename Function>
-  inline std::pair<const std::type_index, std::function<void( Logger &, const std::any & )>> add( const Function &_function ) noexcept {
+  using Visitor = void ( * )( Logger &_logger, const std::any &_any );
+
+  /**
+   * @brief Lock-free open addressing table of visitors for std::any, keyed by the hash of the type.
+   * Visitors are registered at runtime concurrently with lookups, entries are never removed.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class VisitorRegistry : public Singleton<VisitorRegistry> {
+
+  public:
+    /**
+     * @brief Maximum number of registered types.
+     */
+    static constexpr std::size_t capacity = 256;
+
+    /**
+     * @brief Register the visitors for the fundamental types, strings and their containers.
+     */
+    VisitorRegistry() noexcept {
+
+      add<bool, std::int8_t, std::int32_t, std::uint32_t, std::size_t, float, double, const char *, std::string_view, std::string>();
+      add<std::list<bool>, std::list<std::int8_t>, std::list<std::int32_t>, std::list<std::uint32_t>, std::list<std::size_t>, std::list<float>, std::list<double>, std::list<const char *>, std::list<std::string_view>, std::list<std::string>>();
+      add<std::set<bool>, std::set<std::int8_t>, std::set<std::int32_t>, std::set<std::uint32_t>, std::set<std::size_t>, std::set<float>, std::set<double>, std::set<const char *>, std::set<std::string_view>, std::set<std::string, std::less<>>>();
+      add<std::vector<std::int8_t>, std::vector<std::int32_t>, std::vector<std::uint32_t>, std::vector<std::size_t>, std::vector<float>, std::vector<double>, std::vector<const char *>, std::vector<std::string_view>, std::vector<std::string>>();
+    }
+
+    /**
+     * @brief Add or replace the visitor of a type.
+     * @param _type   Type of the value in std::any.
+     * @param _visitor   Visitor for the type.
+     * @return True, if the visitor is registered - false, if the table is full.
+     */
+    bool add( const std::type_info &_type,
+              Visitor _visitor ) noexcept {
+
+      const std::size_t hash = _type.hash_code();
+      for ( std::size_t probe = 0; probe < capacity; probe++ ) {
+
+        Entry &entry = m_entries[ ( hash + probe ) & ( capacity - 1 ) ];
+        const std::type_info *type = entry.type.load( std::memory_order_acquire );
+        if ( type == nullptr && entry.type.compare_exchange_strong( type, &_type, std::memory_order_acq_rel ) ) {
+
+          type = &_type;
+        }
+        if ( *type == _type ) {
+
+          entry.visitor.store( _visitor, std::memory_order_release );
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+     * @brief Find the visitor of a type.
+     * @param _type   Type of the value in std::any.
+     * @return Visitor of the type or nullptr, if the type is not registered.
+     */
+    [[nodiscard]] Visitor find( const std::type_info &_type ) const noexcept {
+
+      const std::size_t hash = _type.hash_code();
+      for ( std::size_t probe = 0; probe < capacity; probe++ ) {
+
+        const Entry &entry = m_entries[ ( hash + probe ) & ( capacity - 1 ) ];
+        const std::type_info *type = entry.type.load( std::memory_order_acquire );
+        if ( type == nullptr ) {
 
-    return {
+          return nullptr;
+        }
+        if ( *type == _type ) {
 
-      std::type_index( typeid( T ) ),
-      [ function = _function ]( Logger &_logger,
-                                [[maybe_unused]] const std::any &_any ) {
-        function( _logger, std::any_cast<const T &>( _any ) );
+          return entry.visitor.load( std::memory_order_acquire );
+        }
       }
+      return nullptr;
+    }
+
+  private:
+    /**
+     * @brief Slot of the table, the type is claimed once and never released.
+     */
+    struct Entry {
+
+      /**
+       * @brief Registered type or nullptr for an empty slot.
+       */
+      std::atomic<const std::type_info *> type { nullptr };
+
+      /**
+       * @brief Visitor of the type, nullptr until it is published.
+       */
+      std::atomic<Visitor> visitor { nullptr };
     };
-  }
 
-#ifdef __clang__
-  #pragma clang diagnostic push
-  #pragma clang diagnostic ignored "-Wexit-time-destructors"
-  #pragma clang diagnostic ignored "-Wglobal-constructors"
-#endif
-  /**
-   * @brief Map of possible visitors for std::any.
-   */
-  const std::unordered_map<std::type_index, std::function<void( Logger &_logger, const std::any & )>> visitors {
-
-    add<bool>( []( Logger &_logger, bool _input ) noexcept { _logger << _input; } ),
-    add<std::int8_t>( []( Logger &_logger, std::int8_t _input ) noexcept { _logger << _input; } ),
-    add<std::int32_t>( []( Logger &_logger, std::int32_t _input ) noexcept { _logger << _input; } ),
-    add<std::uint32_t>( []( Logger &_logger, std::uint32_t _input ) noexcept { _logger << _input; } ),
-    add<std::size_t>( []( Logger &_logger, std::size_t _input ) noexcept { _logger << _input; } ),
-    add<float>( []( Logger &_logger, float _input ) noexcept { _logger << _input; } ),
-    add<double>( []( Logger &_logger, double _input ) noexcept { _logger << _input; } ),
-    add<const char *>( []( Logger &_logger, const char *_input ) noexcept { _logger << _input; } ),
-    add<std::string_view>( []( Logger &_logger, std::string_view _input ) noexcept { _logger << _input; } ),
-    add<std::string>( []( Logger &_logger, const std::string &_input ) noexcept { _logger << _input; } ),
-    add<std::list<bool>>( []( Logger &_logger, const std::list<bool> &_input ) noexcept { _logger << _input; } ),
-    add<std::list<std::int8_t>>( []( Logger &_logger, const std::list<std::int8_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::list<std::int32_t>>( []( Logger &_logger, const std::list<std::int32_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::list<std::uint32_t>>( []( Logger &_logger, const std::list<std::uint32_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::list<std::size_t>>( []( Logger &_logger, const std::list<std::size_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::list<float>>( []( Logger &_logger, const std::list<float> &_input ) noexcept { _logger << _input; } ),
-    add<std::list<double>>( []( Logger &_logger, const std::list<double> &_input ) noexcept { _logger << _input; } ),
-    add<std::list<const char *>>( []( Logger &_logger, const std::list<const char *> &_input ) noexcept { _logger << _input; } ),
-    add<std::list<std::string_view>>( []( Logger &_logger, const std::list<std::string_view> &_input ) noexcept { _logger << _input; } ),
-    add<std::list<std::string>>( []( Logger &_logger, const std::list<std::string> &_input ) noexcept { _logger << _input; } ),
-    add<std::set<bool>>( []( Logger &_logger, const std::set<bool> &_input ) noexcept { _logger << _input; } ),
-    add<std::set<std::int8_t>>( []( Logger &_logger, const std::set<std::int8_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::set<std::int32_t>>( []( Logger &_logger, const std::set<std::int32_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::set<std::uint32_t>>( []( Logger &_logger, const std::set<std::uint32_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::set<std::size_t>>( []( Logger &_logger, const std::set<std::size_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::set<float>>( []( Logger &_logger, const std::set<float> &_input ) noexcept { _logger << _input; } ),
-    add<std::set<double>>( []( Logger &_logger, const std::set<double> &_input ) noexcept { _logger << _input; } ),
-    add<std::set<const char *>>( []( Logger &_logger, const std::set<const char *> &_input ) noexcept { _logger << _input; } ),
-    add<std::set<std::string_view>>( []( Logger &_logger, const std::set<std::string_view> &_input ) noexcept { _logger << _input; } ),
-    add<std::set<std::string, std::less<>>>( []( Logger &_logger, const std::set<std::string, std::less<>> &_input ) noexcept { _logger << _input; } ),
-    add<std::vector<std::int8_t>>( []( Logger &_logger, const std::vector<std::int8_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::vector<std::int32_t>>( []( Logger &_logger, const std::vector<std::int32_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::vector<std::uint32_t>>( []( Logger &_logger, const std::vector<std::uint32_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::vector<std::size_t>>( []( Logger &_logger, const std::vector<std::size_t> &_input ) noexcept { _logger << _input; } ),
-    add<std::vector<float>>( []( Logger &_logger, const std::vector<float> &_input ) noexcept { _logger << _input; } ),
-    add<std::vector<double>>( []( Logger &_logger, const std::vector<double> &_input ) noexcept { _logger << _input; } ),
-    add<std::vector<const char *>>( []( Logger &_logger, const std::vector<const char *> &_input ) noexcept { _logger << _input; } ),
-    add<std::vector<std::string_view>>( []( Logger &_logger, const std::vector<std::string_view> &_input ) noexcept { _logger << _input; } ),
-    add<std::vector<std::string>>( []( Logger &_logger, const std::vector<std::string> &_input ) noexcept { _logger << _input; } ),
+    /**
+     * @brief Write the value with the logger operator of the type.
+     * @param _logger   Logger for the value.
+     * @param _any   Type of std::any holding T.
+     */
+    template <typename T>
+    static void print( Logger &_logger,
+                       const std::any &_any ) noexcept {
+
+      _logger << *std::any_cast<T>( &_any );
+    }
+
+    /**
+     * @brief Add the logger operators of the types.
+     */
+    template <typename... Ts>
+    void add() noexcept {
+
+      ( add( typeid( Ts ), &print<Ts> ), ... );
+    }
+
+    /**
+     * @brief Member for table of visitors.
+     */
+    std::array<Entry, capacity> m_entries {};
   };
-#ifdef __clang__
-  #pragma clang diagnostic pop
-#endif
 
   /**
    * @brief Visit possible visitors.
@@ -139,9 +189,9 @@ namespace vx::logger {
   inline void visit( Logger &_logger,
                      const std::any &_any ) {
 
-    if ( const auto iterator = visitors.find( std::type_index( _any.type() ) ); iterator != visitors.cend() ) {
+    if ( const Visitor visitor = VisitorRegistry::instance().find( _any.type() ); visitor != nullptr ) {
 
-      iterator->second( _logger, _any );
+      visitor( _logger, _any );
     }
     else {
 
@@ -150,13 +200,16 @@ namespace vx::logger {
   }
 
   /**
-   * @brief Register new visitor.
-   * @param _function   Visitor function.
+   * @brief Register new visitor, can be called concurrently with logging.
+   * @tparam T   Type of the value in std::any.
+   * @param _function   Visitor function without captures, e.g. []( Logger &_logger, const T &_value ) { ... }.
+   * @return True, if the visitor is registered - false, if the table is full.
    */
   template <typename T, typename Function>
-  inline void registerVisitor( const Function &_function ) noexcept {
+  inline bool registerVisitor( [[maybe_unused]] const Function &_function ) noexcept {
 
-    visitors.insert( add<T>( _function ) );
+    static_assert( std::is_empty_v<Function> && std::is_default_constructible_v<Function>, "Visitor must not capture anything." );
+    return VisitorRegistry::instance().add( typeid( T ), []( Logger &_logger, const std::any &_any ) { Function {}( _logger, *std::any_cast<T>( &_any ) ); } );
   }
 
   /**
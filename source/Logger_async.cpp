@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* stl header */
+#include <chrono>
+
+/* local header */
+#include "Logger_async.h"
+#include "Logger_json.h"
+#include "Logger_sink.h"
+
+namespace vx::logger {
+
+  /* Records logged during static destruction fall back to synchronous output. */
+  std::atomic<bool> writerShutdown { false };
+
+  namespace {
+
+    /**
+     * @brief Set for the writer thread, its own records are written synchronously.
+     */
+    thread_local bool writerThread = false;
+  }
+
+  AsyncWriter::AsyncWriter() {
+
+    /* The sinks need to outlive the writer thread. */
+    std::ignore = SinkRegistry::instance();
+    m_thread = std::jthread( [ this ]( const std::stop_token &_token ) { run( _token ); } );
+  }
+
+  AsyncWriter::~AsyncWriter() noexcept {
+
+    writerShutdown.store( true, std::memory_order_release );
+    m_thread.request_stop();
+    wakeUp();
+    if ( m_thread.joinable() ) {
+
+      m_thread.join();
+    }
+  }
+
+  bool AsyncWriter::available() noexcept {
+
+    return !writerShutdown.load( std::memory_order_acquire ) && !writerThread;
+  }
+
+  void AsyncWriter::push( Record &&_record,
+                          Overflow _overflow ) noexcept {
+
+    const Severity severity = _record.severity;
+    std::size_t position = 0;
+    while ( !m_queue.tryPush( std::move( _record ), position ) ) {
+
+      /* Queue is full, the memory stays bounded while the output stalls. */
+      if ( _overflow == Overflow::DropNewest || ( _overflow == Overflow::DropBySeverity && severity < Severity::Error ) ) {
+
+        drop( severity );
+        return;
+      }
+      if ( Record oldest {}; _overflow == Overflow::DropOldest && m_queue.tryPop( oldest ) ) {
+
+        drop( oldest.severity );
+        continue;
+      }
+
+      /* The writer thread needs to catch up. */
+      wakeUp();
+      std::this_thread::yield();
+    }
+    wakeUp();
+
+    /* A fatal record is often the last one before the process dies. */
+    if ( severity == Severity::Fatal ) {
+
+      waitWritten( position + 1 );
+    }
+  }
+
+  bool AsyncWriter::accepts( Severity _severity,
+                             Overflow _overflow ) const noexcept {
+
+    /* Block waits for room and DropOldest makes room, only these policies drop a new record. */
+    const bool dropsNewest = _overflow == Overflow::DropNewest || ( _overflow == Overflow::DropBySeverity && _severity < Severity::Error );
+    return !dropsNewest || !m_queue.full();
+  }
+
+  std::uint64_t AsyncWriter::dropped( Severity _severity ) const noexcept {
+
+    return m_dropped[ static_cast<std::size_t>( _severity ) ].load( std::memory_order_relaxed );
+  }
+
+  void AsyncWriter::flush() noexcept {
+
+    /* Includes records, that other threads are still pushing. */
+    waitWritten( m_queue.pushed() );
+  }
+
+  void AsyncWriter::waitWritten( std::size_t _position ) noexcept {
+
+    while ( m_written.load( std::memory_order_acquire ) < _position ) {
+
+      wakeUp();
+      std::this_thread::yield();
+    }
+  }
+
+  void AsyncWriter::wakeUp() noexcept {
+
+    /* Only pay for the lock, if the writer is really waiting. */
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    if ( m_waiting.load( std::memory_order_relaxed ) ) {
+
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      m_condition.notify_one();
+    }
+  }
+
+  void AsyncWriter::drop( Severity _severity ) noexcept {
+
+    m_dropped[ static_cast<std::size_t>( _severity ) ].fetch_add( 1, std::memory_order_relaxed );
+  }
+
+  void AsyncWriter::summarize( bool _final ) noexcept {
+
+    const auto now = std::chrono::steady_clock::now();
+    if ( !_final && now - m_lastSummary < summaryInterval ) {
+
+      return;
+    }
+
+    std::array<std::uint64_t, severities> dropped {};
+    std::uint64_t total = 0;
+    for ( std::size_t severity = 0; severity < severities; severity++ ) {
+
+      dropped[ severity ] = m_dropped[ severity ].load( std::memory_order_relaxed ) - m_summarized[ severity ];
+      m_summarized[ severity ] += dropped[ severity ];
+      total += dropped[ severity ];
+    }
+    if ( total == 0 || !formatted( Severity::Warning ) ) {
+
+      return;
+    }
+    m_lastSummary = now;
+
+    /* Written synchronously, because it is logged by the writer thread. */
+    constexpr std::array<std::string_view, severities> names { "verbose", "debug", "info", "warning", "error", "fatal" };
+    Logger logger( Severity::Warning, logLocation() );
+    logger << "records dropped by overflow policy" << total;
+    for ( std::size_t severity = 0; severity < severities; severity++ ) {
+
+      if ( dropped[ severity ] > 0 ) {
+
+        logger << kv( names[ severity ], dropped[ severity ] );
+      }
+    }
+  }
+
+  void AsyncWriter::run( const std::stop_token &_token ) noexcept {
+
+    writerThread = true;
+    constexpr auto timeout = std::chrono::milliseconds( 100 );
+    SinkRegistry &sinks = SinkRegistry::instance();
+    Record record {};
+    while ( true ) {
+
+      /* Every sink gets the whole batch at once, e.g. the console writes it with a single system call. */
+      std::size_t written = 0;
+      while ( written < batchSize && m_queue.tryPop( record ) ) {
+
+        sinks.append( record.entry() );
+        written++;
+      }
+      if ( written > 0 ) {
+
+        sinks.commit();
+
+        /* Every record before is written now or was dropped by a producer. */
+        m_written.store( m_queue.taken(), std::memory_order_release );
+        summarize( false );
+        continue;
+      }
+      m_written.store( m_queue.taken(), std::memory_order_release );
+      summarize( false );
+      if ( _token.stop_requested() ) {
+
+        summarize( true );
+        break;
+      }
+
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_waiting.store( true, std::memory_order_relaxed );
+      std::atomic_thread_fence( std::memory_order_seq_cst );
+      m_condition.wait_for( lock, timeout, [ this, &_token ] { return !m_queue.empty() || _token.stop_requested(); } );
+      m_waiting.store( false, std::memory_order_relaxed );
+    }
+  }
+}
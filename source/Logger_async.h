@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* stl header */
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint_least32_t, std::uint64_t
+#include <mutex>
+#include <string>
+#include <string_view>
+#ifdef HAVE_JTHREAD
+  #include <thread>
+#else
+  #ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Weverything"
+  #endif
+  #include <jthread.hpp>
+  #ifdef __clang__
+    #pragma clang diagnostic pop
+  #endif
+#endif
+
+/* local header */
+#include "BoundedQueue.h"
+#include "Logger.h"
+#include "Logger_sink.h"
+#include "Singleton.h"
+
+/**
+ * @brief vx (VX APPS) logger namespace.
+ */
+namespace vx::logger {
+
+  /**
+   * @brief Finished log record.
+   */
+  struct Record {
+
+    /**
+     * @brief Default constructor for Record.
+     */
+    Record() = default;
+
+    /**
+     * @brief Constructor for Record, copies the parts of the entry.
+     * @param _entry   Finished record.
+     */
+    explicit Record( const Entry &_entry )
+      : severity( _entry.severity ),
+        time( _entry.time ),
+        file( _entry.file ),
+        line( _entry.line ),
+        function( _entry.function ),
+        text( _entry.text ),
+        headerSize( _entry.headerSize ),
+        fields( _entry.fields ),
+        category( _entry.category ) {}
+
+    /**
+     * @brief View of the record for the sinks.
+     * @return Entry, that is valid as long as the record.
+     */
+    [[nodiscard]] inline Entry entry() const noexcept { return { severity, time, file, line, function, text, headerSize, fields, category }; }
+
+    /**
+     * @brief Severity of the record.
+     */
+    Severity severity = Severity::Debug;
+
+    /**
+     * @brief Point in time, when the record was created.
+     */
+    std::chrono::system_clock::time_point time {};
+
+    /**
+     * @brief Source file of the record, a string literal.
+     */
+    std::string_view file {};
+
+    /**
+     * @brief Source line of the record.
+     */
+    std::uint_least32_t line = 0;
+
+    /**
+     * @brief Function of the record, a string literal.
+     */
+    std::string_view function {};
+
+    /**
+     * @brief Complete formatted line including header and newline.
+     */
+    std::string text {};
+
+    /**
+     * @brief Size of the header at the beginning of the text.
+     */
+    std::size_t headerSize = 0;
+
+    /**
+     * @brief Structured fields as JSON members.
+     */
+    std::string fields {};
+
+    /**
+     * @brief Category of the record.
+     */
+    std::string category {};
+  };
+
+  /**
+   * @brief Background writer for asynchronous logging.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class AsyncWriter : public Singleton<AsyncWriter> {
+
+  public:
+    /**
+     * @brief Default constructor for AsyncWriter.
+     */
+    AsyncWriter();
+
+    /**
+     * @brief Default destructor for AsyncWriter, writes out all pending records.
+     */
+    ~AsyncWriter() noexcept;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    AsyncWriter( const AsyncWriter & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    AsyncWriter( AsyncWriter && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    AsyncWriter &operator=( const AsyncWriter & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    AsyncWriter &operator=( AsyncWriter && ) = delete;
+
+    /**
+     * @brief Is the writer still accepting records?
+     * @return False, if the writer is already shut down or called from the writer thread - otherwise true.
+     */
+    [[nodiscard]] static bool available() noexcept;
+
+    /**
+     * @brief Hand over a finished record to the writer thread, a full queue is handled by the overflow policy.
+     * @param _record   Record to write.
+     * @param _overflow   Overflow policy of the record.
+     */
+    void push( Record &&_record,
+               Overflow _overflow ) noexcept;
+
+    /**
+     * @brief Will a record be queued now or dropped by the overflow policy?
+     * @param _severity   Severity of the record.
+     * @param _overflow   Overflow policy of the record.
+     * @return False, if the queue is full and the policy drops a new record of this severity - otherwise true.
+     * @note Only a snapshot, when other threads are logging.
+     */
+    [[nodiscard]] bool accepts( Severity _severity,
+                                Overflow _overflow ) const noexcept;
+
+    /**
+     * @brief Number of records dropped by the overflow policy.
+     * @param _severity   Severity of the dropped records.
+     * @return Dropped records of this severity since start.
+     */
+    [[nodiscard]] std::uint64_t dropped( Severity _severity ) const noexcept;
+
+    /**
+     * @brief Block until every record pushed so far is written.
+     */
+    void flush() noexcept;
+
+  private:
+    /**
+     * @brief Maximum number of pending records.
+     */
+    static constexpr std::size_t queueSize = 8192;
+
+    /**
+     * @brief Maximum number of records in a batch.
+     */
+    static constexpr std::size_t batchSize = 1024;
+
+    /**
+     * @brief Number of severities.
+     */
+    static constexpr std::size_t severities = static_cast<std::size_t>( Severity::Fatal ) + 1;
+
+    /**
+     * @brief Minimum interval between two summaries of dropped records.
+     */
+    static constexpr std::chrono::seconds summaryInterval { 1 };
+
+    /**
+     * @brief Drain the queue until stop is requested.
+     * @param _token   Stop token of the writer thread.
+     */
+    void run( const std::stop_token &_token ) noexcept;
+
+    /**
+     * @brief Wake up the writer thread, if it is waiting.
+     */
+    void wakeUp() noexcept;
+
+    /**
+     * @brief Block until every record before a position of the queue is written or dropped.
+     * @param _position   Position of the queue.
+     */
+    void waitWritten( std::size_t _position ) noexcept;
+
+    /**
+     * @brief Count a dropped record.
+     * @param _severity   Severity of the dropped record.
+     */
+    void drop( Severity _severity ) noexcept;
+
+    /**
+     * @brief Log a warning with the records dropped since the last summary, only called by the writer thread.
+     * @param _final   True, to ignore the summary interval.
+     */
+    void summarize( bool _final ) noexcept;
+
+    /**
+     * @brief Member for pending records.
+     */
+    BoundedQueue<Record> m_queue { queueSize };
+
+    /**
+     * @brief Member for position of the queue, before that every record is written or dropped.
+     */
+    std::atomic<std::size_t> m_written { 0 };
+
+    /**
+     * @brief Member for dropped records per severity.
+     */
+    std::array<std::atomic<std::uint64_t>, severities> m_dropped {};
+
+    /**
+     * @brief Member for dropped records per severity, that are already summarized.
+     */
+    std::array<std::uint64_t, severities> m_summarized {};
+
+    /**
+     * @brief Member for point in time of the last summary.
+     */
+    std::chrono::steady_clock::time_point m_lastSummary {};
+
+    /**
+     * @brief Member for the waiting state of the writer thread.
+     */
+    std::atomic<bool> m_waiting { false };
+
+    /**
+     * @brief Member for mutex, only used when the writer thread waits.
+     */
+    std::mutex m_mutex {};
+
+    /**
+     * @brief Condition member.
+     */
+    std::condition_variable m_condition {};
+
+    /**
+     * @brief Member for writer thread, needs to be the last member.
+     */
+    std::jthread m_thread {};
+  };
+}
@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* stl header */
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <utility> // std::pair
+
+/* local header */
+#include "Logger_binary.h"
+#include "Singleton.h"
+
+namespace vx::logger::binary {
+
+  namespace {
+
+    /**
+     * @brief Magic bytes at the beginning of a binary log.
+     */
+    constexpr std::array<char, 4> magic { 'V', 'X', 'B', 'L' };
+
+    /**
+     * @brief Version of the binary log format.
+     */
+    constexpr std::uint32_t version = 1;
+
+    /**
+     * @brief Registered call site.
+     */
+    struct Site {
+
+      /**
+       * @brief Severity of the call site.
+       */
+      Severity severity = Severity::Debug;
+
+      /**
+       * @brief Source file of the call site.
+       */
+      std::string file {};
+
+      /**
+       * @brief Function of the call site.
+       */
+      std::string function {};
+
+      /**
+       * @brief Source line of the call site.
+       */
+      std::uint32_t line = 0;
+
+      /**
+       * @brief Argument types of the call site.
+       */
+      std::vector<Type> types {};
+    };
+
+    /**
+     * @brief Owner of the binary log file, the call sites and the thread buffers.
+     */
+    class Writer : public Singleton<Writer> {
+
+    public:
+      /**
+       * @brief Mutex for the thread buffer registry.
+       */
+      std::mutex registryMutex {};
+
+      /**
+       * @brief Buffers of all threads.
+       */
+      std::set<Buffer *> buffers {};
+
+      /**
+       * @brief Mutex for file and call sites.
+       */
+      std::mutex fileMutex {};
+
+      /**
+       * @brief Binary log file.
+       */
+      std::ofstream file {};
+
+      /**
+       * @brief Registered call sites, the index is the id.
+       */
+      std::vector<Site> sites {};
+
+      /**
+       * @brief Write raw bytes of a value, the file mutex must be locked.
+       * @param _value   Value to write.
+       */
+      template <typename T>
+      void put( const T &_value ) {
+
+        file.write( reinterpret_cast<const char *>( &_value ), sizeof( T ) ); // NOSONAR raw bytes are written
+      }
+
+      /**
+       * @brief Write a string with its length, the file mutex must be locked.
+       * @param _value   String to write.
+       */
+      void putString( std::string_view _value ) {
+
+        put( static_cast<std::uint32_t>( _value.size() ) );
+        file.write( _value.data(), static_cast<std::streamsize>( _value.size() ) );
+      }
+
+      /**
+       * @brief Write a call site, the file mutex must be locked.
+       * @param _id   Id of the call site.
+       */
+      void putSite( std::uint32_t _id ) {
+
+        const Site &site = sites[ _id ];
+        put( static_cast<char>( 'S' ) );
+        put( _id );
+        put( static_cast<std::uint8_t>( site.severity ) );
+        put( site.line );
+        putString( site.file );
+        putString( site.function );
+        put( static_cast<std::uint8_t>( site.types.size() ) );
+        for ( const Type type : site.types ) {
+
+          put( type );
+        }
+      }
+    };
+
+    /**
+     * @brief Read raw bytes of a value.
+     * @param _input   Binary log input.
+     * @param _value   Value to read.
+     * @return True, if the value was read - otherwise false.
+     */
+    template <typename T>
+    bool get( std::istream &_input,
+              T &_value ) {
+
+      return static_cast<bool>( _input.read( reinterpret_cast<char *>( &_value ), sizeof( T ) ) ); // NOSONAR raw bytes are read
+    }
+
+    /**
+     * @brief Read a string with its length.
+     * @param _input   Binary log input.
+     * @param _value   String to read.
+     * @return True, if the string was read - otherwise false.
+     */
+    bool getString( std::istream &_input,
+                    std::string &_value ) {
+
+      std::uint32_t size = 0;
+      if ( !get( _input, size ) ) {
+
+        return false;
+      }
+      _value.resize( size );
+      return static_cast<bool>( _input.read( _value.data(), static_cast<std::streamsize>( size ) ) );
+    }
+
+    /**
+     * @brief Read an argument and replay it into the logger.
+     * @tparam T   Type of the argument.
+     * @param _input   Binary log input.
+     * @param _logger   Logger to replay the argument.
+     * @return True, if the argument was read - otherwise false.
+     */
+    template <typename T>
+    bool replay( std::istream &_input,
+                 Logger &_logger ) {
+
+      T value {};
+      if ( !get( _input, value ) ) {
+
+        return false;
+      }
+      _logger << value;
+      return true;
+    }
+
+    /**
+     * @brief Read an argument and replay it into the logger.
+     * @param _input   Binary log input.
+     * @param _type   Type of the argument.
+     * @param _logger   Logger to replay the argument.
+     * @return True, if the argument was read - otherwise false.
+     */
+    bool replay( std::istream &_input,
+                 Type _type,
+                 Logger &_logger ) {
+
+      std::string value {};
+      switch ( _type ) {
+
+        case Type::Bool:
+          return replay<bool>( _input, _logger );
+        case Type::Char:
+          return replay<char>( _input, _logger );
+        case Type::Int8:
+          return replay<std::int8_t>( _input, _logger );
+        case Type::Int32:
+          return replay<std::int32_t>( _input, _logger );
+        case Type::UInt32:
+          return replay<std::uint32_t>( _input, _logger );
+        case Type::Size:
+#if defined _WIN32 && !defined _WIN64
+          return replay<std::uint32_t>( _input, _logger );
+#else
+          return replay<std::size_t>( _input, _logger );
+#endif
+        case Type::Time:
+          return replay<std::time_t>( _input, _logger );
+        case Type::Float:
+          return replay<float>( _input, _logger );
+        case Type::Double:
+          return replay<double>( _input, _logger );
+        case Type::CString:
+          if ( !getString( _input, value ) ) {
+
+            return false;
+          }
+          _logger << value.c_str();
+          return true;
+        case Type::String:
+          if ( !getString( _input, value ) ) {
+
+            return false;
+          }
+          _logger << value;
+          return true;
+        case Type::StringView:
+          if ( !getString( _input, value ) ) {
+
+            return false;
+          }
+          _logger << std::string_view { value };
+          return true;
+      }
+      return false;
+    }
+  }
+
+  Buffer::Buffer() {
+
+    m_data.reserve( flushSize + flushSize / 2 );
+    Writer &writer = Writer::instance();
+    const std::lock_guard<std::mutex> lock( writer.registryMutex );
+    writer.buffers.insert( this );
+  }
+
+  Buffer::~Buffer() noexcept {
+
+    flush();
+    Writer &writer = Writer::instance();
+    const std::lock_guard<std::mutex> lock( writer.registryMutex );
+    writer.buffers.erase( this );
+  }
+
+  void Buffer::flush() noexcept {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    writeOut();
+  }
+
+  void Buffer::writeOut() noexcept {
+
+    if ( m_data.empty() ) {
+
+      return;
+    }
+    Writer &writer = Writer::instance();
+    const std::lock_guard<std::mutex> lock( writer.fileMutex );
+    if ( writer.file.is_open() ) {
+
+      writer.file.write( m_data.data(), static_cast<std::streamsize>( m_data.size() ) );
+    }
+    m_data.clear();
+  }
+
+  Buffer &threadBuffer() noexcept {
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+    thread_local Buffer buffer {};
+    return buffer;
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+  }
+
+  std::uint32_t registerSite( Severity _severity,
+                              const std::source_location &_location,
+                              std::initializer_list<Type> _types ) {
+
+    Writer &writer = Writer::instance();
+    const std::lock_guard<std::mutex> lock( writer.fileMutex );
+    const auto id = static_cast<std::uint32_t>( writer.sites.size() );
+    writer.sites.push_back( { _severity, std::string { _location.file_name() }, std::string { _location.function_name() }, _location.line(), _types } );
+    if ( writer.file.is_open() ) {
+
+      writer.putSite( id );
+    }
+    return id;
+  }
+
+  bool open( const std::string &_filename ) {
+
+    close();
+
+    Writer &writer = Writer::instance();
+    const std::lock_guard<std::mutex> lock( writer.fileMutex );
+    writer.file.open( _filename, std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( !writer.file.is_open() ) {
+
+      return false;
+    }
+    writer.file.write( magic.data(), magic.size() );
+    writer.put( version );
+    for ( std::uint32_t id = 0; id < writer.sites.size(); id++ ) {
+
+      writer.putSite( id );
+    }
+    return static_cast<bool>( writer.file );
+  }
+
+  void close() noexcept {
+
+    Writer &writer = Writer::instance();
+    const std::lock_guard<std::mutex> registryLock( writer.registryMutex );
+    for ( Buffer *buffer : writer.buffers ) {
+
+      buffer->flush();
+    }
+    const std::lock_guard<std::mutex> fileLock( writer.fileMutex );
+    if ( writer.file.is_open() ) {
+
+      writer.file.close();
+    }
+  }
+
+  bool decode( std::istream &_input,
+               std::ostream &_output ) {
+
+    std::array<char, magic.size()> header {};
+    std::uint32_t fileVersion = 0;
+    if ( !_input.read( header.data(), header.size() ) || header != magic || !get( _input, fileVersion ) || fileVersion != version ) {
+
+      return false;
+    }
+
+    std::vector<Site> sites {};
+    std::vector<std::pair<std::int64_t, std::string>> records {};
+    char tag = 0;
+    while ( get( _input, tag ) ) {
+
+      if ( tag == 'S' ) {
+
+        std::uint32_t id = 0;
+        std::uint8_t severity = 0;
+        std::uint8_t count = 0;
+        Site site {};
+        if ( !get( _input, id ) || !get( _input, severity ) || !get( _input, site.line ) || !getString( _input, site.file ) || !getString( _input, site.function ) || !get( _input, count ) ) {
+
+          return false;
+        }
+        site.severity = static_cast<Severity>( severity );
+        site.types.resize( count );
+        for ( Type &type : site.types ) {
+
+          if ( !get( _input, type ) ) {
+
+            return false;
+          }
+        }
+        if ( id >= sites.size() ) {
+
+          sites.resize( id + 1 );
+        }
+        sites[ id ] = std::move( site );
+      }
+      else if ( tag == 'R' ) {
+
+        std::uint32_t id = 0;
+        std::int64_t timestamp = 0;
+        if ( !get( _input, id ) || id >= sites.size() || !get( _input, timestamp ) ) {
+
+          return false;
+        }
+        const Site &site = sites[ id ];
+        const std::chrono::system_clock::time_point timePoint { std::chrono::duration_cast<std::chrono::system_clock::duration>( std::chrono::nanoseconds( timestamp ) ) };
+        std::ostringstream text {};
+        {
+          Logger logger( site.severity, std::source_location::current( site.file, site.function, site.line, 0 ), timePoint, text );
+          for ( const Type type : site.types ) {
+
+            if ( !replay( _input, type, logger ) ) {
+
+              return false;
+            }
+          }
+        }
+        records.emplace_back( timestamp, text.str() );
+      }
+      else {
+
+        return false;
+      }
+    }
+
+    /* Every thread writes its own buffer, so the records are sorted afterwards. */
+    std::stable_sort( records.begin(), records.end(), []( const auto &_left, const auto &_right ) { return _left.first < _right.first; } );
+    for ( const auto &[ timestamp, text ] : records ) {
+
+      _output << text;
+    }
+    return true;
+  }
+}
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstdint> // std::int8_t, std::int32_t, std::uint8_t, std::uint32_t
+#include <cstring> // std::memcpy
+
+/* stl header */
+#include <chrono>
+#include <ctime> // std::time_t
+#include <initializer_list>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <source_location.hpp>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/* local header */
+#include "Logger.h"
+
+/**
+ * @brief vx (VX APPS) logger binary namespace, deferred formatting of records.
+ */
+namespace vx::logger::binary {
+
+  /**
+   * @brief The Type enum for encoded arguments.
+   */
+  enum class Type : std::uint8_t {
+
+    Bool,       /**< bool */
+    Char,       /**< char */
+    Int8,       /**< std::int8_t */
+    Int32,      /**< std::int32_t */
+    UInt32,     /**< std::uint32_t */
+    Size,       /**< std::size_t */
+    Time,       /**< std::time_t */
+    Float,      /**< float */
+    Double,     /**< double */
+    CString,    /**< const char * */
+    String,     /**< std::string */
+    StringView  /**< std::string_view */
+  };
+
+  /**
+   * @brief Encoded type of an argument, only types with an exact Logger overload are supported.
+   * @tparam T   Argument type.
+   */
+  template <typename T>
+  struct TypeOf {
+
+    static_assert( !std::is_same_v<T, T>, "Type is not supported by the binary logger." );
+  };
+
+  /** @cond */
+  template <>
+  struct TypeOf<bool> : std::integral_constant<Type, Type::Bool> {};
+  template <>
+  struct TypeOf<char> : std::integral_constant<Type, Type::Char> {};
+  template <>
+  struct TypeOf<std::int8_t> : std::integral_constant<Type, Type::Int8> {};
+  template <>
+  struct TypeOf<std::int32_t> : std::integral_constant<Type, Type::Int32> {};
+  template <>
+  struct TypeOf<std::uint32_t> : std::integral_constant<Type, Type::UInt32> {};
+#if !defined _WIN32 || defined _WIN64
+  template <>
+  struct TypeOf<std::size_t> : std::integral_constant<Type, Type::Size> {};
+#endif
+  template <>
+  struct TypeOf<std::time_t> : std::integral_constant<Type, Type::Time> {};
+  template <>
+  struct TypeOf<float> : std::integral_constant<Type, Type::Float> {};
+  template <>
+  struct TypeOf<double> : std::integral_constant<Type, Type::Double> {};
+  template <>
+  struct TypeOf<const char *> : std::integral_constant<Type, Type::CString> {};
+  template <>
+  struct TypeOf<char *> : std::integral_constant<Type, Type::CString> {};
+  template <std::size_t N>
+  struct TypeOf<char[ N ]> : std::integral_constant<Type, Type::CString> {};
+  template <>
+  struct TypeOf<std::string> : std::integral_constant<Type, Type::String> {};
+  template <>
+  struct TypeOf<std::string_view> : std::integral_constant<Type, Type::StringView> {};
+  /** @endcond */
+
+  /**
+   * @brief Per-thread buffer for encoded records.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Buffer {
+
+  public:
+    /**
+     * @brief Default constructor for Buffer.
+     */
+    Buffer();
+
+    /**
+     * @brief Default destructor for Buffer, writes out the pending records.
+     */
+    ~Buffer() noexcept;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    Buffer( const Buffer & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    Buffer( Buffer && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    Buffer &operator=( const Buffer & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    Buffer &operator=( Buffer && ) = delete;
+
+    /**
+     * @brief Append a record.
+     * @param _id   Id of the call site.
+     * @param _args   Arguments of the record.
+     */
+    template <typename... Args>
+    void record( std::uint32_t _id,
+                 const Args &..._args ) noexcept {
+
+      const std::int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::system_clock::now().time_since_epoch() ).count();
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      put( static_cast<char>( 'R' ) );
+      put( _id );
+      put( timestamp );
+      ( encode( _args ), ... );
+      if ( m_data.size() >= flushSize ) {
+
+        writeOut();
+      }
+    }
+
+    /**
+     * @brief Write out the pending records.
+     */
+    void flush() noexcept;
+
+  private:
+    /**
+     * @brief Buffer size, when the records are written out.
+     */
+    static constexpr std::size_t flushSize = 64 * 1024;
+
+    /**
+     * @brief Append raw bytes of a value.
+     * @param _value   Value to append.
+     */
+    template <typename T>
+    inline void put( const T &_value ) noexcept {
+
+      const std::size_t size = m_data.size();
+      m_data.resize( size + sizeof( T ) );
+      std::memcpy( m_data.data() + size, &_value, sizeof( T ) );
+    }
+
+    /**
+     * @brief Append a string with its length.
+     * @param _value   String to append.
+     */
+    inline void putString( std::string_view _value ) noexcept {
+
+      put( static_cast<std::uint32_t>( _value.size() ) );
+      m_data.insert( m_data.end(), _value.cbegin(), _value.cend() );
+    }
+
+    /**
+     * @brief Encode an argument.
+     * @param _value   Argument to encode.
+     */
+    template <typename T>
+    inline void encode( const T &_value ) noexcept {
+
+      constexpr Type type = TypeOf<T>::value;
+      if constexpr ( type == Type::CString && std::is_array_v<T> ) {
+
+        putString( _value );
+      }
+      else if constexpr ( type == Type::CString ) {
+
+        putString( _value == nullptr ? std::string_view {} : std::string_view { _value } );
+      }
+      else if constexpr ( type == Type::String || type == Type::StringView ) {
+
+        putString( _value );
+      }
+      else {
+
+        put( _value );
+      }
+    }
+
+    /**
+     * @brief Write out the pending records, the mutex must be locked.
+     */
+    void writeOut() noexcept;
+
+    /**
+     * @brief Member for mutex, only contended while another thread closes the log.
+     */
+    std::mutex m_mutex {};
+
+    /**
+     * @brief Member for encoded records.
+     */
+    std::vector<char> m_data {};
+  };
+
+  /**
+   * @brief Get the buffer of the current thread.
+   * @return Buffer of the current thread.
+   */
+  Buffer &threadBuffer() noexcept;
+
+  /**
+   * @brief Register a call site.
+   * @param _severity   Severity of the call site.
+   * @param _location   Source location of the call site.
+   * @param _types   Argument types of the call site.
+   * @return Id of the call site.
+   */
+  std::uint32_t registerSite( Severity _severity,
+                              const std::source_location &_location,
+                              std::initializer_list<Type> _types );
+
+  /**
+   * @brief Open the binary log file, the call sites known so far are written first.
+   * @param _filename   The filename.
+   * @return True, if the file is open - otherwise false.
+   */
+  bool open( const std::string &_filename );
+
+  /**
+   * @brief Write out the buffers of all threads and close the binary log file.
+   */
+  void close() noexcept;
+
+  /**
+   * @brief Decode a binary log into the text, that Logger produces.
+   * @param _input   Binary log input.
+   * @param _output   Text output.
+   * @return True, if the input was decoded completely - otherwise false.
+   */
+  bool decode( std::istream &_input,
+               std::ostream &_output );
+
+  /**
+   * @brief Write a record with deferred formatting.
+   * @tparam Site   Unique type of the call site.
+   * @param _severity   Severity of the record.
+   * @param _location   Source location of the call site.
+   * @param _args   Arguments of the record.
+   */
+  template <typename Site, typename... Args>
+  void write( [[maybe_unused]] Site _site,
+              Severity _severity,
+              const std::source_location &_location,
+              const Args &..._args ) noexcept {
+
+    static const std::uint32_t id = registerSite( _severity, _location, { TypeOf<Args>::value... } );
+    threadBuffer().record( id, _args... );
+  }
+}
+
+/* Every call site gets its own id, the arguments are formatted later by the decoder. */
+#define logBinary( _severity, ... ) ( _severity ) < vx::logger::minimumSeverity || !vx::logger::enabled( _severity ) ? static_cast<void>( 0 ) : vx::logger::binary::write( [] {}, _severity, logLocation(), __VA_ARGS__ )
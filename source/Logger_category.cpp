@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* stl header */
+#include <algorithm>
+
+/* local header */
+#include "Logger_category.h"
+
+namespace vx::logger {
+
+  Category &Categories::category( std::string_view _name ) {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    return find( _name );
+  }
+
+  void Categories::setLevel( std::string_view _name,
+                             Severity _severity ) {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    find( _name ).m_configured = _severity;
+    propagate();
+  }
+
+  void Categories::resetLevel( std::string_view _name ) {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    find( _name ).m_configured.reset();
+    propagate();
+  }
+
+  void Categories::setSampling( std::string_view _name,
+                                std::uint32_t _rate ) {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    find( _name ).m_configuredSampling = std::max<std::uint32_t>( _rate, 1 );
+    propagate();
+  }
+
+  void Categories::resetSampling( std::string_view _name ) {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    find( _name ).m_configuredSampling.reset();
+    propagate();
+  }
+
+  void Categories::refresh() {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    propagate();
+  }
+
+  Category &Categories::find( std::string_view _name ) {
+
+    if ( const auto iterator = m_categories.find( _name ); iterator != m_categories.end() ) {
+
+      return iterator->second;
+    }
+
+    /* Parents exist before their children, so a new child inherits their level. */
+    if ( const std::size_t delimiter = _name.rfind( '.' ); delimiter != std::string_view::npos ) {
+
+      find( _name.substr( 0, delimiter ) );
+    }
+    Category &category = m_categories.try_emplace( std::string( _name ), _name ).first->second;
+    propagate();
+    return category;
+  }
+
+  void Categories::propagate() noexcept {
+
+    /* Resolved here, so the check of a record never reads the settings. */
+    const Settings settings = Configuration::instance().settings();
+
+    /* Parents are sorted before their children, "net" < "net.serial". */
+    for ( auto &[ name, category ] : m_categories ) {
+
+      const Category *parent = nullptr;
+      if ( const std::size_t delimiter = name.rfind( '.' ); delimiter != std::string::npos ) {
+
+        parent = &m_categories.find( std::string_view( name ).substr( 0, delimiter ) )->second;
+      }
+
+      Severity level = settings.avoidLogBelow;
+      if ( category.m_configured ) {
+
+        level = *category.m_configured;
+      }
+      else if ( parent != nullptr ) {
+
+        level = parent->m_level.load( std::memory_order_relaxed );
+      }
+      category.m_level.store( level, std::memory_order_relaxed );
+      category.m_threshold.store( settings.flightRecorder ? Severity::Verbose : level, std::memory_order_relaxed );
+
+      std::uint32_t sampling = Category::inheritSampling;
+      if ( category.m_configuredSampling ) {
+
+        sampling = *category.m_configuredSampling;
+      }
+      else if ( parent != nullptr ) {
+
+        sampling = parent->m_sampling.load( std::memory_order_relaxed );
+      }
+      category.m_sampling.store( sampling, std::memory_order_relaxed );
+    }
+  }
+}
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+
+/* stl header */
+#include <algorithm> // std::copy_n
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/* local header */
+#include "Logger.h"
+
+/**
+ * @brief vx (VX APPS) logger namespace.
+ */
+namespace vx::logger {
+
+  /**
+   * @brief Named category with its own level, e.g. "net" or "net.serial".
+   * A category without own level inherits the level of the closest parent, "net.serial" the one of "net", and without any the global avoidLogBelow.
+   * The sampling rate is inherited the same way and falls back to the sampling rate of the severity.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Category {
+
+  public:
+    /**
+     * @brief Constructor for Category.
+     * @param _name   Dot separated name of the category.
+     */
+    explicit Category( std::string_view _name )
+      : m_name( _name ) {}
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    Category( const Category & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    Category( Category && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    Category &operator=( const Category & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    Category &operator=( Category && ) = delete;
+
+    /**
+     * @brief Default destructor for Category.
+     */
+    ~Category() = default;
+
+    /**
+     * @brief Get name.
+     * @return Dot separated name of the category.
+     */
+    [[nodiscard]] inline std::string_view name() const noexcept { return m_name; }
+
+    /**
+     * @brief Get effective level, a single atomic load.
+     * @return Logging below this level will not be written.
+     */
+    [[nodiscard]] inline Severity level() const noexcept { return m_level.load( std::memory_order_relaxed ); }
+
+    /**
+     * @brief Get lowest severity, that is formatted to be written or to be captured by the flight recorder, a single atomic load.
+     * @return Logging below this severity is not formatted.
+     */
+    [[nodiscard]] inline Severity threshold() const noexcept { return m_threshold.load( std::memory_order_relaxed ); }
+
+    /**
+     * @brief Get effective sampling rate, a single atomic load.
+     * @param _severity   Severity of the record.
+     * @param _settings   Settings of the record, that provide the sampling rate of the severity.
+     * @return Write 1 in N records - 0 and 1 write every record.
+     */
+    [[nodiscard]] inline std::uint32_t sampling( Severity _severity,
+                                                 const Settings &_settings ) const noexcept {
+
+      const std::uint32_t rate = m_sampling.load( std::memory_order_relaxed );
+      return rate == inheritSampling ? _settings.sampling[ static_cast<std::size_t>( _severity ) ] : rate;
+    }
+
+  private:
+    friend class Categories;
+
+    /**
+     * @brief Effective sampling rate, that falls back to the sampling rate of the severity.
+     */
+    static constexpr std::uint32_t inheritSampling = 0;
+
+    /**
+     * @brief Member for name.
+     */
+    std::string m_name {};
+
+    /**
+     * @brief Member for configured level, guarded by the mutex of Categories.
+     */
+    std::optional<Severity> m_configured {};
+
+    /**
+     * @brief Member for effective level of this category, read without lock on every record.
+     */
+    std::atomic<Severity> m_level { Severity::Verbose };
+
+    /**
+     * @brief Member for lowest formatted severity of this category, read without lock on every record.
+     */
+    std::atomic<Severity> m_threshold { Severity::Verbose };
+
+    /**
+     * @brief Member for configured sampling rate, guarded by the mutex of Categories.
+     */
+    std::optional<std::uint32_t> m_configuredSampling {};
+
+    /**
+     * @brief Member for effective sampling rate of this category, read without lock on every record.
+     */
+    std::atomic<std::uint32_t> m_sampling { inheritSampling };
+  };
+
+  /**
+   * @brief Registry of all categories, categories are created on first use and never removed.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Categories : public Singleton<Categories> {
+
+  public:
+    /**
+     * @brief Find or create a category, the reference stays valid for the lifetime of the program.
+     * @param _name   Dot separated name of the category.
+     * @return Category of the name.
+     */
+    [[nodiscard]] Category &category( std::string_view _name );
+
+    /**
+     * @brief Set level of a category, that is inherited by its children without own level.
+     * @param _name   Dot separated name of the category.
+     * @param _severity   Logging below this level will not written.
+     */
+    void setLevel( std::string_view _name,
+                   Severity _severity );
+
+    /**
+     * @brief Remove the own level of a category, it inherits the level of its parent again.
+     * @param _name   Dot separated name of the category.
+     */
+    void resetLevel( std::string_view _name );
+
+    /**
+     * @brief Set sampling rate of a category, that is inherited by its children without own rate.
+     * @param _name   Dot separated name of the category.
+     * @param _rate   Write 1 in N records below Error, chosen at random - 1 writes every record.
+     */
+    void setSampling( std::string_view _name,
+                      std::uint32_t _rate );
+
+    /**
+     * @brief Remove the own sampling rate of a category, it inherits the rate of its parent again.
+     * @param _name   Dot separated name of the category.
+     */
+    void resetSampling( std::string_view _name );
+
+    /**
+     * @brief Recalculate the inherited levels, after avoidLogBelow or the flight recorder changed.
+     */
+    void refresh();
+
+  private:
+    /**
+     * @brief Find or create a category, the mutex is locked.
+     * @param _name   Dot separated name of the category.
+     * @return Category of the name.
+     */
+    Category &find( std::string_view _name );
+
+    /**
+     * @brief Recalculate the effective level, threshold and sampling rate of every category, the mutex is locked.
+     */
+    void propagate() noexcept;
+
+    /**
+     * @brief Member for mutex to create and configure categories.
+     */
+    std::mutex m_mutex {};
+
+    /**
+     * @brief Member for categories by name.
+     */
+    std::map<std::string, Category, std::less<>> m_categories {};
+  };
+
+  /**
+   * @brief Name of a category as template argument, e.g. "net.serial".
+   * @tparam Size   Size of the string literal including the terminating null.
+   */
+  template <std::size_t Size>
+  struct CategoryName {
+
+    /**
+     * @brief Constructor for CategoryName from a string literal.
+     * @param _name   Dot separated name of the category.
+     */
+    consteval CategoryName( const char ( &_name )[ Size ] ) noexcept { std::copy_n( _name, Size, name.data() ); } // NOSONAR implicit, converted from the string literal.
+
+    /**
+     * @brief Get name.
+     * @return Dot separated name of the category.
+     */
+    [[nodiscard]] constexpr std::string_view view() const noexcept { return { name.data(), Size - 1 }; }
+
+    /**
+     * @brief Member for characters of the name, public to be a template argument.
+     */
+    std::array<char, Size> name {};
+  };
+
+  /**
+   * @brief Resolve a category once, every call site with the same name shares it.
+   * @tparam Name   Name of the category.
+   * @return Category of the name.
+   */
+  template <CategoryName Name>
+  [[nodiscard]] const Category &category() {
+
+    static const Category &category = Categories::instance().category( Name.view() );
+    return category;
+  }
+
+  /**
+   * @brief Will a record of this severity in this category be written?
+   * @param _severity   Severity to check.
+   * @param _category   Category of the record.
+   * @return True, if the severity passes the compile time and the level of the category - otherwise false.
+   */
+  [[nodiscard]] inline bool enabled( Severity _severity,
+                                     const Category &_category ) noexcept {
+
+    return _severity >= minimumSeverity && _severity >= _category.level();
+  }
+
+  /**
+   * @brief Will a record of this severity in this category be formatted, either to be written or to be captured by the flight recorder?
+   * @param _severity   Severity to check.
+   * @param _category   Category of the record.
+   * @return True, if the severity passes the compile time limit and is written or captured - otherwise false.
+   */
+  [[nodiscard]] inline bool formatted( Severity _severity,
+                                       const Category &_category ) noexcept {
+
+    return _severity >= minimumSeverity && _severity >= _category.threshold();
+  }
+}
+
+/* The category is resolved once per name, later checks are a single atomic load. */
+#define logCategory( _category, _severity, ... ) ( _severity ) < vx::logger::minimumSeverity || !vx::logger::formatted( _severity, vx::logger::category<_category>() ) ? static_cast<void>( 0 ) : vx::logger::Voidify() & vx::logger::Logger( _severity, vx::logger::category<_category>(), logLocation() ).logger( __VA_ARGS__ )
+#define logVerboseIn( _category, ... ) logCategory( _category, vx::logger::Severity::Verbose, __VA_ARGS__ )
+#define logDebugIn( _category, ... ) logCategory( _category, vx::logger::Severity::Debug, __VA_ARGS__ )
+#define logInfoIn( _category, ... ) logCategory( _category, vx::logger::Severity::Info, __VA_ARGS__ )
+#define logWarningIn( _category, ... ) logCategory( _category, vx::logger::Severity::Warning, __VA_ARGS__ )
+#define logErrorIn( _category, ... ) logCategory( _category, vx::logger::Severity::Error, __VA_ARGS__ )
+#define logFatalIn( _category, ... ) logCategory( _category, vx::logger::Severity::Fatal, __VA_ARGS__ )
@@ -32,12 +32,18 @@
 
 /* stl header */
 #include <array>
-#include <functional>
+#include <cstddef> // std::byte, std::size_t
 #include <list>
 #include <map>
 #include <optional>
+#include <ranges>
 #include <set>
+#include <span>
+#include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits> // std::is_same_v
+#include <typeinfo>
 #include <unordered_map>
 #include <utility> // std::pair
 #include <variant>
@@ -52,6 +58,25 @@
  */
 namespace vx::logger {
 
+  /**
+   * @brief Return the readable name of the type T.
+   * The name is demangled once per type and kept for the lifetime of the program, so formatting a container does not run the demangler and does not allocate.
+   * @return Readable type name.
+   */
+  template <typename T>
+  const std::string &typeName() noexcept {
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+    static const std::string name = demangle::extreme( typeid( T ).name() );
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+    return name;
+  }
+
   /**
    * @brief Logger operator for std::optional.
    * @param _logger   Logger as input.
@@ -62,7 +87,7 @@ namespace vx::logger {
   Logger &operator<<( Logger &_logger,
                       const std::optional<T> &_optional ) noexcept {
 
-    _logger.stream() << demangle::extreme( typeid( _optional ).name() ) << ' ';
+    _logger.stream() << typeName<std::optional<T>>() << ' ';
     if ( _optional ) {
 
       const bool saveState = _logger.autoSpace();
@@ -97,38 +122,60 @@ namespace vx::logger {
   }
 
   /**
-   * @brief Helper function for list.
+   * @brief Helper function for the elements of a range, elements beyond maxElements or maxRecordSize are elided as "... N more" or as "... more" without size.
    * @param _logger   Logger as input.
-   * @param _list   List type to output.
-   * @return Logger with output.
+   * @param _range   Range type to output.
+   * @param _print   Writes a single element.
    */
-  template <typename List>
-  Logger &printList( Logger &_logger,
-                     const List &_list ) noexcept {
+  template <typename Range, typename Print>
+  void printElements( Logger &_logger,
+                      const Range &_range,
+                      Print _print ) noexcept {
 
-    using func = std::function<void( void )>;
-    func checkComma {};
-    const func printComma = [ &_logger ]() noexcept { _logger.stream() << ',' << ' '; };
-    const func noPrint = [ &checkComma, &printComma ]() noexcept { checkComma = printComma; };
-    checkComma = noPrint;
+    _logger.stream() << '{';
+    std::size_t index = 0;
+    auto iterator = std::ranges::begin( _range );
+    const auto end = std::ranges::end( _range );
+    for ( ; iterator != end; ++iterator, ++index ) {
 
-    _logger.stream() << demangle::extreme( typeid( _list ).name() ) << ' ' << '{';
-    for ( const auto &value : _list ) {
+      if ( _logger.exhausted( index ) ) {
 
-      try {
+        break;
+      }
+      if ( index > 0 ) {
 
-        checkComma();
+        _logger.stream() << ',' << ' ';
       }
-      catch ( const std::bad_function_call &_exception ) {
+      _print( *iterator );
+    }
+    if ( iterator != end ) {
+
+      _logger.stream() << ( index > 0 ? ", ... " : "... " );
+      if constexpr ( std::ranges::sized_range<const Range> ) {
 
-        /* Nothing to do here, the delimeter is not the most important thing here. */
-        logFatal() << "bad_function_call:" << _exception.what();
+        _logger.stream() << static_cast<std::size_t>( std::ranges::size( _range ) ) - index << ' ';
       }
-      const bool saveState = _logger.autoSpace();
-      _logger.nospace() << value;
-      _logger.setAutoSpace( saveState );
+
+      /* The rest of a range without size is not walked, it might be endless. */
+      _logger.stream() << "more";
     }
     _logger.stream() << '}';
+  }
+
+  /**
+   * @brief Helper function for list.
+   * @param _logger   Logger as input.
+   * @param _list   List type to output.
+   * @return Logger with output.
+   */
+  template <typename List>
+  Logger &printList( Logger &_logger,
+                     const List &_list ) noexcept {
+
+    _logger.stream() << typeName<List>() << ' ';
+    const bool saveState = _logger.autoSpace();
+    printElements( _logger, _list, [ &_logger ]( const auto &_value ) noexcept { _logger.nospace() << _value; } );
+    _logger.setAutoSpace( saveState );
     return _logger.maybeSpace();
   }
 
@@ -184,6 +231,53 @@ namespace vx::logger {
     return printList( _logger, _vector );
   }
 
+  /**
+   * @brief Logger operator for std::span, views are written without copying them into a container.
+   * Byte buffers are written as hexadecimal bytes.
+   * @param _logger   Logger as input.
+   * @param _span   Span to logger.
+   * @return Logger with output.
+   */
+  template <typename T, std::size_t Extent>
+  Logger &operator<<( Logger &_logger,
+                      std::span<T, Extent> _span ) noexcept {
+
+    _logger.stream() << "std::span<" << typeName<T>() << '>' << ' ';
+    if constexpr ( std::is_same_v<std::remove_cv_t<T>, std::byte> ) {
+
+      printElements( _logger, _span, [ &_logger ]( std::byte _byte ) noexcept {
+        constexpr std::string_view digits = "0123456789abcdef";
+        const auto value = std::to_integer<std::size_t>( _byte );
+        _logger.stream() << digits[ value >> 4 ] << digits[ value & 0xf ];
+      } );
+    }
+    else {
+
+      const bool saveState = _logger.autoSpace();
+      printElements( _logger, _span, [ &_logger ]( const auto &_value ) noexcept { _logger.nospace() << _value; } );
+      _logger.setAutoSpace( saveState );
+    }
+    return _logger.maybeSpace();
+  }
+
+  /**
+   * @brief Logger operator for any other range, e.g. std::deque or std::views::iota( 0, 10 ).
+   * Strings and ranges of itself, like std::filesystem::path, are not written as range.
+   * @param _logger   Logger as input.
+   * @param _range   Range to logger.
+   * @return Logger with output.
+   */
+  template <typename Range>
+  requires std::ranges::input_range<const Range> && ( !std::is_convertible_v<const Range &, std::string_view> ) && ( !std::is_same_v<std::remove_cvref_t<std::ranges::range_reference_t<const Range>>, Range> )
+  Logger &operator<<( Logger &_logger,
+                      const Range &_range ) noexcept {
+
+    const bool saveState = _logger.autoSpace();
+    printElements( _logger, _range, [ &_logger ]( const auto &_value ) noexcept { _logger.nospace() << _value; } );
+    _logger.setAutoSpace( saveState );
+    return _logger.maybeSpace();
+  }
+
   /**
    * @brief Helper function for map.
    * @param _logger   Logger as input.
@@ -194,33 +288,16 @@ namespace vx::logger {
   Logger &printMap( Logger &_logger,
                     const T &_map ) noexcept {
 
-    using func = std::function<void( void )>;
-    func checkComma {};
-    const func printComma = [ &_logger ]() noexcept { _logger.stream() << ',' << ' '; };
-    const func noPrint = [ &checkComma, &printComma ]() noexcept { checkComma = printComma; };
-    checkComma = noPrint;
-
-    _logger.stream() << demangle::extreme( typeid( _map ).name() ) << ' ' << '{';
-    for ( const auto &[ key, value ] : _map ) {
-
-      try {
-
-        checkComma();
-      }
-      catch ( const std::bad_function_call &_exception ) {
-
-        /* Nothing to do here, the delimeter is not the most important thing here. */
-        logFatal() << "bad_function_call:" << _exception.what();
-      }
+    _logger.stream() << typeName<T>() << ' ';
+    printElements( _logger, _map, [ &_logger ]( const auto &_element ) noexcept {
       _logger.stream() << '{';
       const bool saveState = _logger.autoSpace();
-      _logger.nospace() << key;
+      _logger.nospace() << _element.first;
       _logger.stream() << ',' << ' ';
-      _logger << value;
+      _logger << _element.second;
       _logger.setAutoSpace( saveState );
       _logger.stream() << '}';
-    }
-    _logger.stream() << '}';
+    } );
     return _logger.maybeSpace();
   }
 
@@ -273,27 +350,14 @@ namespace vx::logger {
   Logger &printTuple( Logger &_logger,
                       const T &_tuple ) noexcept {
 
-    using func = std::function<void( void )>;
-    func checkComma {};
-    const func printComma = [ &_logger ]() noexcept { _logger.stream() << ',' << ' '; };
-    const func noPrint = [ &checkComma, &printComma ]() noexcept { checkComma = printComma; };
-    checkComma = noPrint;
-
-    _logger.stream() << demangle::extreme( typeid( _tuple ).name() ) << ' ' << '{';
-    std::size_t tupleSize = std::tuple_size_v<T>;
-    for ( std::size_t pos = 0; pos < tupleSize; pos++ ) {
-
-      try {
-
-        checkComma();
-      }
-      catch ( const std::bad_function_call &_exception ) {
-
-        /* Nothing to do here, the delimeter is not the most important thing here. */
-        logFatal() << "bad_function_call:" << _exception.what();
-      }
-      _logger.printTuple( pos, _tuple );
-    }
+    _logger.stream() << typeName<T>() << ' ' << '{';
+    const bool saveState = _logger.autoSpace();
+    std::apply( [ &_logger ]( const auto &..._values ) noexcept {
+      std::size_t pos = 0;
+      ( ( _logger.stream() << ( pos++ == 0 ? "" : ", " ), _logger.nospace() << _values ), ... );
+    },
+                _tuple );
+    _logger.setAutoSpace( saveState );
     _logger.stream() << '}';
     return _logger.maybeSpace();
   }
@@ -321,12 +385,16 @@ namespace vx::logger {
   Logger &printVariant( Logger &_logger,
                         const T &_variant ) noexcept {
 
-    _logger.stream() << demangle::extreme( typeid( _variant ).name() ) << ' ';
-    std::size_t variantSize = std::variant_size_v<T>;
-    for ( std::size_t pos = 0; pos < variantSize; pos++ ) {
+    _logger.stream() << typeName<T>() << ' ';
+    if ( _variant.valueless_by_exception() ) {
 
-      _logger.printVariant( pos, _variant );
+      _logger.stream() << "(valueless)";
+      return _logger.maybeSpace();
     }
+
+    const bool saveState = _logger.autoSpace();
+    std::visit( [ &_logger ]( const auto &_value ) noexcept { _logger.nospace() << _value; }, _variant );
+    _logger.setAutoSpace( saveState );
     return _logger.maybeSpace();
   }
 
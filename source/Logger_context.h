@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+
+/* stl header */
+#include <array>
+#include <charconv> // std::to_chars
+#include <concepts> // std::integral, std::same_as
+#include <limits>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief vx (VX APPS) logger namespace.
+ */
+namespace vx::logger {
+
+  /**
+   * @brief Diagnostic context of the current thread, e.g. a request id, that is added to every record created within the scope.
+   * Scopes are nested on a thread-local stack, pushing and popping only moves a pointer.
+   * The context is rendered when the record is created, so it also reaches records, that are written asynchronously.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Context {
+
+  public:
+    /**
+     * @brief Constructor for Context with a text value.
+     * @param _key   Key of the context, a string literal.
+     * @param _value   Value of the context, it is referenced and has to outlive the scope.
+     */
+    Context( std::string_view _key,
+             std::string_view _value ) noexcept
+      : m_key( _key ),
+        m_value( _value ),
+        m_previous( top() ) {
+
+      top() = this;
+    }
+
+    /**
+     * @brief Constructor for Context with a number.
+     * @param _key   Key of the context, a string literal.
+     * @param _value   Value of the context.
+     */
+    template <std::integral T>
+      requires( !std::same_as<T, bool> && !std::same_as<T, char> && !std::same_as<T, wchar_t> && !std::same_as<T, char8_t> && !std::same_as<T, char16_t> && !std::same_as<T, char32_t> )
+    Context( std::string_view _key,
+             T _value ) noexcept
+      : m_key( _key ),
+        m_number( true ),
+        m_previous( top() ) {
+
+      const auto result = std::to_chars( m_buffer.data(), m_buffer.data() + m_buffer.size(), _value );
+      m_value = { m_buffer.data(), static_cast<std::size_t>( result.ptr - m_buffer.data() ) };
+      top() = this;
+    }
+
+    /**
+     * @brief Constructor for Context with a flag, it is written as true or false.
+     * @param _key   Key of the context, a string literal.
+     * @param _value   Value of the context.
+     */
+    template <typename T>
+      requires std::same_as<T, bool>
+    Context( std::string_view _key,
+             T _value ) noexcept
+      : m_key( _key ),
+        m_value( _value ? "true" : "false" ),
+        m_number( true ),
+        m_previous( top() ) {
+
+      top() = this;
+    }
+
+    /**
+     * @brief Constructor for Context with a character, it is written as text.
+     * @param _key   Key of the context, a string literal.
+     * @param _value   Value of the context.
+     */
+    template <typename T>
+      requires std::same_as<T, char>
+    Context( std::string_view _key,
+             T _value ) noexcept
+      : m_key( _key ),
+        m_previous( top() ) {
+
+      m_buffer[ 0 ] = _value;
+      m_value = { m_buffer.data(), 1 };
+      top() = this;
+    }
+
+    /**
+     * @brief Delete constructor for wide characters, that have no single byte text.
+     */
+    template <typename T>
+      requires std::same_as<T, wchar_t> || std::same_as<T, char8_t> || std::same_as<T, char16_t> || std::same_as<T, char32_t>
+    Context( std::string_view, T ) = delete;
+
+    /**
+     * @brief Delete constructor for temporary strings, that would not outlive the scope.
+     */
+    template <typename T>
+      requires std::same_as<T, std::string>
+    Context( std::string_view, T && ) = delete;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    Context( const Context & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    Context( Context && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    Context &operator=( const Context & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    Context &operator=( Context && ) = delete;
+
+    /**
+     * @brief Default destructor for Context, removes the context from the stack.
+     */
+    ~Context() noexcept { top() = m_previous; }
+
+    /**
+     * @brief Innermost context of the current thread.
+     * @return Innermost context or nullptr, if there is no context.
+     */
+    [[nodiscard]] static inline const Context *current() noexcept { return top(); }
+
+    /**
+     * @brief Get key.
+     * @return Key of the context.
+     */
+    [[nodiscard]] inline std::string_view key() const noexcept { return m_key; }
+
+    /**
+     * @brief Get value.
+     * @return Value of the context.
+     */
+    [[nodiscard]] inline std::string_view value() const noexcept { return m_value; }
+
+    /**
+     * @brief Is the value a number or a flag, that is written without quotes?
+     * @return True, if the value is a number or a flag - otherwise false.
+     */
+    [[nodiscard]] inline bool number() const noexcept { return m_number; }
+
+    /**
+     * @brief Get the enclosing context.
+     * @return Enclosing context or nullptr, if this is the outermost one.
+     */
+    [[nodiscard]] inline const Context *previous() const noexcept { return m_previous; }
+
+  private:
+    /**
+     * @brief Top of the stack of the current thread.
+     * @return Innermost context of the current thread.
+     */
+    static const Context *&top() noexcept {
+
+      thread_local const Context *current = nullptr;
+      return current;
+    }
+
+    /**
+     * @brief Member for key.
+     */
+    std::string_view m_key {};
+
+    /**
+     * @brief Member for value.
+     */
+    std::string_view m_value {};
+
+    /**
+     * @brief Member for number or flag state of the value.
+     */
+    bool m_number = false;
+
+    /**
+     * @brief Member for enclosing context.
+     */
+    const Context *m_previous = nullptr;
+
+    /**
+     * @brief Member for text of a number.
+     */
+    std::array<char, std::numeric_limits<unsigned long long>::digits10 + 2> m_buffer {};
+  };
+}
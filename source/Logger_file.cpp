@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* stl header */
+#include <filesystem>
+
+/* local header */
+#include "Logger_file.h"
+
+namespace vx::logger {
+
+  FileSink::FileSink( Severity _threshold )
+    : Sink( _threshold ),
+      m_thread( [ this ]( const std::stop_token &_token ) { run( _token ); } ) {}
+
+  FileSink::~FileSink() noexcept {
+
+    m_thread.request_stop();
+    {
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      m_condition.notify_one();
+    }
+    if ( m_thread.joinable() ) {
+
+      m_thread.join();
+    }
+  }
+
+  bool FileSink::open( const std::string &_filename ) {
+
+    flush();
+    const std::lock_guard<std::mutex> lock( m_fileMutex );
+    m_filename = _filename;
+    return reopen( std::ios::out | std::ios::app );
+  }
+
+  void FileSink::close() noexcept {
+
+    flush();
+    const std::lock_guard<std::mutex> lock( m_fileMutex );
+    m_file.close();
+  }
+
+  void FileSink::write( const Entry &_entry ) noexcept {
+
+    try {
+
+      std::unique_lock<std::mutex> lock( m_mutex );
+      while ( m_buffer.size() >= maximumSize && m_thread.joinable() && !m_thread.get_stop_token().stop_requested() ) {
+
+        /* The disk is slower than the records, wait for the background thread. */
+        m_condition.notify_one();
+        m_writtenCondition.wait( lock );
+      }
+      m_buffer.append( _entry.text );
+      m_appended += _entry.text.size();
+      if ( m_buffer.size() >= bufferSize ) {
+
+        m_condition.notify_one();
+      }
+    }
+    catch ( const std::bad_alloc & ) {
+
+      /* Nothing to do here, the records are lost. */
+    }
+
+    /* A fatal record is often the last one before the process dies. */
+    if ( _entry.severity == Severity::Fatal ) {
+
+      flush();
+    }
+  }
+
+  void FileSink::flush() noexcept {
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    const std::uint64_t target = m_appended;
+    if ( m_written >= target ) {
+
+      return;
+    }
+    m_flushRequested = target;
+    m_condition.notify_one();
+    m_writtenCondition.wait( lock, [ this, target ] { return m_written >= target; } );
+  }
+
+  void FileSink::run( const std::stop_token &_token ) noexcept {
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    while ( true ) {
+
+      m_condition.wait_for( lock, flushInterval, [ this, &_token ] {
+
+        return m_buffer.size() >= bufferSize || m_flushRequested > m_written || _token.stop_requested();
+      } );
+
+      const std::uint64_t target = m_appended;
+      m_pending.swap( m_buffer );
+      lock.unlock();
+
+      /* The file is written and rotated without blocking the logging threads. */
+      writeOut( m_pending );
+      m_pending.clear();
+
+      lock.lock();
+      m_written = target;
+      m_writtenCondition.notify_all();
+      if ( _token.stop_requested() && m_buffer.empty() ) {
+
+        break;
+      }
+    }
+  }
+
+  void FileSink::writeOut( std::string_view _text ) noexcept {
+
+    const std::lock_guard<std::mutex> lock( m_fileMutex );
+    if ( !m_file.is_open() ) {
+
+      return;
+    }
+
+    if ( const std::chrono::seconds interval = Configuration::instance().rotationInterval(); interval != m_interval ) {
+
+      m_interval = interval;
+      m_rotation = nextRotation( m_interval );
+    }
+    const std::uintmax_t maxFileSize = Configuration::instance().maxFileSize();
+    if ( std::chrono::system_clock::now() >= m_rotation || ( maxFileSize > 0 && m_fileSize > 0 && m_fileSize + _text.size() > maxFileSize ) ) {
+
+      rotate();
+    }
+    if ( _text.empty() || !m_file.is_open() ) {
+
+      return;
+    }
+    m_file.write( _text.data(), static_cast<std::streamsize>( _text.size() ) );
+    m_file.flush();
+    m_fileSize += _text.size();
+  }
+
+  void FileSink::rotate() noexcept {
+
+    m_file.close();
+    try {
+
+      const std::size_t maxFiles = Configuration::instance().maxFiles();
+      const auto rotated = [ this ]( std::size_t _number ) { return m_filename + '.' + std::to_string( _number ); };
+      std::error_code error {};
+      if ( maxFiles == 0 ) {
+
+        std::filesystem::remove( m_filename, error );
+      }
+      else {
+
+        std::filesystem::remove( rotated( maxFiles ), error );
+        for ( std::size_t number = maxFiles - 1; number > 0; number-- ) {
+
+          std::filesystem::rename( rotated( number ), rotated( number + 1 ), error );
+        }
+        std::filesystem::rename( m_filename, rotated( 1 ), error );
+      }
+    }
+    catch ( const std::bad_alloc & ) {
+
+      /* Nothing to do here, the file is truncated. */
+    }
+    reopen( std::ios::out | std::ios::trunc );
+  }
+
+  bool FileSink::reopen( std::ios::openmode _mode ) noexcept {
+
+    try {
+
+      m_file.close();
+
+      /* The records are already collected in the buffer of the sink. */
+      m_file.rdbuf()->pubsetbuf( nullptr, 0 );
+      m_file.open( m_filename, _mode | std::ios::binary );
+      std::error_code error {};
+      const std::uintmax_t size = std::filesystem::file_size( m_filename, error );
+      m_fileSize = error ? 0 : size;
+    }
+    catch ( const std::exception & ) {
+
+      m_file.close();
+    }
+    m_rotation = nextRotation( m_interval );
+    return m_file.is_open();
+  }
+
+  std::chrono::system_clock::time_point FileSink::nextRotation( std::chrono::seconds _interval ) noexcept {
+
+    if ( _interval <= std::chrono::seconds::zero() ) {
+
+      return std::chrono::system_clock::time_point::max();
+    }
+    const auto now = std::chrono::duration_cast<std::chrono::seconds>( std::chrono::system_clock::now().time_since_epoch() );
+    return std::chrono::system_clock::time_point( ( now / _interval + 1 ) * _interval );
+  }
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+/* stl header */
+#include <chrono>
+#include <condition_variable>
+#include <cstdint> // std::uint64_t, std::uintmax_t
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#ifdef HAVE_JTHREAD
+  #include <thread>
+#else
+  #ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Weverything"
+  #endif
+  #include <jthread.hpp>
+  #ifdef __clang__
+    #pragma clang diagnostic pop
+  #endif
+#endif
+
+/* local header */
+#include "Logger.h"
+#include "Logger_sink.h"
+
+/**
+ * @brief vx (VX APPS) logger namespace.
+ */
+namespace vx::logger {
+
+  /**
+   * @brief File output of the logger with a large buffer and rotation by a background thread.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class FileSink : public Sink {
+
+  public:
+    /**
+     * @brief Default constructor for FileSink.
+     * @param _threshold   Records below this severity are not written to the sink.
+     */
+    explicit FileSink( Severity _threshold = Severity::Verbose );
+
+    /**
+     * @brief Default destructor for FileSink, writes out the buffer.
+     */
+    ~FileSink() noexcept override;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    FileSink( const FileSink & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    FileSink( FileSink && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    FileSink &operator=( const FileSink & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    FileSink &operator=( FileSink && ) = delete;
+
+    /**
+     * @brief Open a file and append to it.
+     * @param _filename   The filename.
+     * @return True, if the file is open - otherwise false.
+     */
+    bool open( const std::string &_filename );
+
+    /**
+     * @brief Write out the buffer and close the file.
+     */
+    void close() noexcept override;
+
+    /**
+     * @brief Append a finished record to the buffer.
+     * @param _entry   Record, only valid during the call.
+     */
+    void write( const Entry &_entry ) noexcept override;
+
+    /**
+     * @brief Block until everything appended so far is in the file.
+     */
+    void flush() noexcept override;
+
+  private:
+    /**
+     * @brief Buffer size, when the background thread writes out.
+     */
+    static constexpr std::size_t bufferSize = 256 * 1024;
+
+    /**
+     * @brief Buffer size, when writing blocks until the background thread caught up.
+     */
+    static constexpr std::size_t maximumSize = 16 * bufferSize;
+
+    /**
+     * @brief Interval, when the background thread writes out a partial buffer.
+     */
+    static constexpr std::chrono::milliseconds flushInterval { 200 };
+
+    /**
+     * @brief Write out the buffer until stop is requested.
+     * @param _token   Stop token of the background thread.
+     */
+    void run( const std::stop_token &_token ) noexcept;
+
+    /**
+     * @brief Write records to the file and rotate, if necessary.
+     * @param _text   Complete records.
+     */
+    void writeOut( std::string_view _text ) noexcept;
+
+    /**
+     * @brief Rotate the file to filename.1, filename.1 to filename.2 and so on.
+     */
+    void rotate() noexcept;
+
+    /**
+     * @brief Open the file.
+     * @param _mode   Open mode.
+     * @return True, if the file is open - otherwise false.
+     */
+    bool reopen( std::ios::openmode _mode ) noexcept;
+
+    /**
+     * @brief Next point in time, when the file is rotated.
+     * @param _interval   Rotation interval.
+     * @return Next multiple of the rotation interval or max, if there is no interval.
+     */
+    static std::chrono::system_clock::time_point nextRotation( std::chrono::seconds _interval ) noexcept;
+
+    /**
+     * @brief Member for buffer, that collects records.
+     */
+    std::string m_buffer {};
+
+    /**
+     * @brief Member for buffer, that is written out by the background thread.
+     */
+    std::string m_pending {};
+
+    /**
+     * @brief Member for number of bytes appended to the buffer.
+     */
+    std::uint64_t m_appended = 0;
+
+    /**
+     * @brief Member for number of bytes written out.
+     */
+    std::uint64_t m_written = 0;
+
+    /**
+     * @brief Member for number of bytes, that shall be written out immediately.
+     */
+    std::uint64_t m_flushRequested = 0;
+
+    /**
+     * @brief Member for mutex of the buffer.
+     */
+    std::mutex m_mutex {};
+
+    /**
+     * @brief Condition member to wake up the background thread.
+     */
+    std::condition_variable m_condition {};
+
+    /**
+     * @brief Condition member to signal written out bytes.
+     */
+    std::condition_variable m_writtenCondition {};
+
+    /**
+     * @brief Member for mutex of the file.
+     */
+    std::mutex m_fileMutex {};
+
+    /**
+     * @brief Member for filename.
+     */
+    std::string m_filename {};
+
+    /**
+     * @brief Member for file.
+     */
+    std::ofstream m_file {};
+
+    /**
+     * @brief Member for current file size.
+     */
+    std::uintmax_t m_fileSize = 0;
+
+    /**
+     * @brief Member for rotation interval.
+     */
+    std::chrono::seconds m_interval { 0 };
+
+    /**
+     * @brief Member for next rotation by interval.
+     */
+    std::chrono::system_clock::time_point m_rotation = std::chrono::system_clock::time_point::max();
+
+    /**
+     * @brief Member for background thread, needs to be the last member.
+     */
+    std::jthread m_thread {};
+  };
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* stl header */
+#include <algorithm> // std::find, std::min
+#include <utility> // std::move
+
+/* local header */
+#include "Logger_json.h"
+#include "Timestamp.h"
+
+namespace vx::logger {
+
+  namespace {
+
+    /**
+     * @brief JSON line of the current thread, reused for every record.
+     * @return JSON line buffer.
+     */
+    std::string &lineBuffer() noexcept {
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+      thread_local std::string line {};
+      return line;
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+    }
+
+    /**
+     * @brief Serialize the record and hand it over to the output.
+     * @param _entry   Record.
+     * @param _output   Output of the JSON line.
+     * @param _deliver   Sink::write or Sink::append of the output.
+     */
+    void deliver( const Entry &_entry,
+                  Sink &_output,
+                  void ( Sink::*_deliver )( const Entry & ) noexcept ) noexcept {
+
+      try {
+
+        std::string &line = lineBuffer();
+        line.clear();
+        json::appendEntry( line, _entry );
+
+        Entry entry = _entry;
+        entry.text = line;
+        entry.headerSize = 0;
+        entry.fields = {};
+        ( _output.*_deliver )( entry );
+      }
+      catch ( const std::bad_alloc & ) {
+
+        /* Nothing to do here, the record is lost. */
+      }
+    }
+  }
+
+  namespace json {
+
+    void appendString( std::string &_output,
+                       std::string_view _text ) {
+
+      constexpr std::string_view hex = "0123456789abcdef";
+      constexpr unsigned char control = 0x20;
+
+      _output += '"';
+      std::size_t begin = 0;
+      for ( std::size_t pos = 0; pos < _text.size(); pos++ ) {
+
+        const auto character = static_cast<unsigned char>( _text[ pos ] );
+        if ( character >= control && character != '"' && character != '\\' ) {
+
+          continue;
+        }
+
+        /* Copy the unescaped run at once. */
+        _output.append( _text.data() + begin, pos - begin );
+        begin = pos + 1;
+        switch ( character ) {
+
+          case '"':
+            _output += "\\\"";
+            break;
+          case '\\':
+            _output += "\\\\";
+            break;
+          case '\n':
+            _output += "\\n";
+            break;
+          case '\r':
+            _output += "\\r";
+            break;
+          case '\t':
+            _output += "\\t";
+            break;
+          default:
+            _output += "\\u00";
+            _output += hex[ character >> 4 ];
+            _output += hex[ character & 0xf ];
+            break;
+        }
+      }
+      _output.append( _text.data() + begin, _text.size() - begin );
+      _output += '"';
+    }
+
+    void appendKey( std::string &_output,
+                    std::string_view _key ) {
+
+      /* Duplicate keys are resolved differently by every consumer, so fields never shadow the record. */
+      constexpr std::array<std::string_view, 8> reserved { "time", "severity", "file", "line", "function", "category", "message", "sampleRate" };
+      if ( std::find( reserved.begin(), reserved.end(), _key ) != reserved.end() ) {
+
+        _output += "\"_";
+        _output += _key;
+        _output += "\":";
+        return;
+      }
+      appendString( _output, _key );
+      _output += ':';
+    }
+
+    void appendEntry( std::string &_output,
+                      const Entry &_entry ) {
+
+      constexpr std::array<std::string_view, 6> severities { "verbose", "debug", "info", "warning", "error", "fatal" };
+
+      std::string_view message = _entry.text.substr( std::min( _entry.headerSize, _entry.text.size() ) );
+      while ( !message.empty() && ( message.back() == '\n' || message.back() == ' ' ) ) {
+
+        message.remove_suffix( 1 );
+      }
+
+      timestamp::Iso8601Buffer timestamp {};
+      _output += "{\"time\":\"";
+      _output += timestamp::iso8601( _entry.time, timestamp::Precision::MicroSeconds, timestamp );
+      _output += "\",\"severity\":\"";
+      _output += severities.at( static_cast<std::size_t>( _entry.severity ) );
+      _output += "\",\"file\":";
+      appendString( _output, _entry.file );
+      _output += ",\"line\":";
+      appendNumber( _output, _entry.line );
+      _output += ",\"function\":";
+      appendString( _output, _entry.function );
+      if ( !_entry.category.empty() ) {
+
+        _output += ",\"category\":";
+        appendString( _output, _entry.category );
+      }
+      _output += ",\"message\":";
+      appendString( _output, message );
+      _output += _entry.fields;
+      _output += "}\n";
+    }
+  }
+
+  JsonSink::JsonSink( std::shared_ptr<Sink> _output,
+                      Severity _threshold ) noexcept
+    : Sink( _threshold ),
+      m_output( std::move( _output ) ) {}
+
+  void JsonSink::write( const Entry &_entry ) noexcept {
+
+    deliver( _entry, *m_output, &Sink::write );
+  }
+
+  void JsonSink::append( const Entry &_entry ) noexcept {
+
+    deliver( _entry, *m_output, &Sink::append );
+  }
+
+  void JsonSink::commit() noexcept {
+
+    m_output->commit();
+  }
+
+  void JsonSink::flush() noexcept {
+
+    m_output->flush();
+  }
+
+  void JsonSink::close() noexcept {
+
+    m_output->close();
+  }
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* stl header */
+#include <array>
+#include <charconv> // std::to_chars
+#include <cmath> // std::isfinite
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t
+#include <cstdio> // std::snprintf
+#include <limits>
+#include <memory> // std::shared_ptr
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/* local header */
+#include "Logger.h"
+#include "Logger_sink.h"
+
+/**
+ * @brief vx (VX APPS) logger namespace.
+ */
+namespace vx::logger {
+
+  /**
+   * @brief JSON serialization of records.
+   */
+  namespace json {
+
+    /**
+     * @brief Append a quoted and escaped JSON string.
+     * @param _output   Output to append to.
+     * @param _text   Text to escape.
+     */
+    void appendString( std::string &_output,
+                       std::string_view _text );
+
+    /**
+     * @brief Append the key of a structured field, keys of the record itself get the prefix '_', e.g. "_message".
+     * @param _output   Output to append to.
+     * @param _key   Key of the field.
+     */
+    void appendKey( std::string &_output,
+                    std::string_view _key );
+
+    /**
+     * @brief Append a JSON number, not finite values are null.
+     * @param _output   Output to append to.
+     * @param _value   Number.
+     */
+    template <typename T>
+    void appendNumber( std::string &_output,
+                       T _value ) {
+
+      if constexpr ( std::is_floating_point_v<T> ) {
+
+        if ( !std::isfinite( _value ) ) {
+
+          _output += "null";
+          return;
+        }
+      }
+
+      std::array<char, std::numeric_limits<long double>::max_digits10 + 16> buffer {};
+#if __cpp_lib_to_chars >= 201611L
+      const auto result = std::to_chars( buffer.data(), buffer.data() + buffer.size(), _value );
+      _output.append( buffer.data(), result.ptr );
+#else
+      if constexpr ( std::is_floating_point_v<T> ) {
+
+        const std::int32_t size = std::snprintf( buffer.data(), buffer.size(), "%.17g", static_cast<double>( _value ) );
+        _output.append( buffer.data(), static_cast<std::size_t>( size ) );
+      }
+      else {
+
+        const auto result = std::to_chars( buffer.data(), buffer.data() + buffer.size(), _value );
+        _output.append( buffer.data(), result.ptr );
+      }
+#endif
+    }
+
+    /**
+     * @brief Append a record as a single JSON line with severity, timestamp, source location, category, message and fields.
+     * @param _output   Output to append to.
+     * @param _entry   Record.
+     */
+    void appendEntry( std::string &_output,
+                      const Entry &_entry );
+  }
+
+  /**
+   * @brief Structured field of a record, created with kv().
+   * @tparam T   Type of the value.
+   */
+  template <typename T>
+  struct Field {
+
+    /**
+     * @brief Key of the field.
+     */
+    std::string_view key;
+
+    /**
+     * @brief Value of the field, only valid within the statement.
+     */
+    const T &value;
+  };
+
+  /**
+   * @brief Structured field, written as key=value and as JSON member to structured sinks, e.g. logInfo() << "login" << kv( "user", id ).
+   * Keys of the record itself (time, severity, file, line, function, category, message and sampleRate) get the prefix '_' in JSON.
+   * @param _key   Key of the field.
+   * @param _value   Value of the field.
+   * @return Field for the logger.
+   */
+  template <typename T>
+  [[nodiscard]] Field<T> kv( std::string_view _key,
+                             const T &_value ) noexcept {
+
+    return { _key, _value };
+  }
+
+  /**
+   * @brief Logger operator for a structured field.
+   * Numbers and booleans are JSON numbers and booleans, everything else a JSON string with the text of the value.
+   * @param _logger   Logger as input.
+   * @param _field   Field to logger.
+   * @return Logger with output.
+   */
+  template <typename T>
+  Logger &operator<<( Logger &_logger,
+                      const Field<T> &_field ) {
+
+    std::string *text = _logger.text();
+    std::string *fields = _logger.fields();
+    if ( text == nullptr || fields == nullptr ) {
+
+      return _logger;
+    }
+
+    _logger.stream() << _field.key << '=';
+    const std::size_t begin = text->size();
+    const bool saveState = _logger.autoSpace();
+    _logger.nospace() << _field.value;
+    _logger.setAutoSpace( saveState );
+
+    *fields += ',';
+    json::appendKey( *fields, _field.key );
+    if constexpr ( std::is_same_v<T, bool> ) {
+
+      *fields += _field.value ? "true" : "false";
+    }
+    else if constexpr ( std::is_arithmetic_v<T> && !std::is_same_v<T, char> ) {
+
+      json::appendNumber( *fields, _field.value );
+    }
+    else if constexpr ( std::is_convertible_v<const T &, std::string_view> ) {
+
+      json::appendString( *fields, std::string_view( _field.value ) );
+    }
+    else if constexpr ( std::is_same_v<T, char> ) {
+
+      json::appendString( *fields, std::string_view( &_field.value, 1 ) );
+    }
+    else {
+
+      json::appendString( *fields, std::string_view( *text ).substr( begin ) );
+    }
+    return _logger.maybeSpace();
+  }
+
+  /**
+   * @brief Sink, that writes every record as a single JSON line to another sink, e.g. a FileSink.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class JsonSink : public Sink {
+
+  public:
+    /**
+     * @brief Default constructor for JsonSink.
+     * @param _output   Sink for the JSON lines, it is not registered itself.
+     * @param _threshold   Records below this severity are not written to the sink.
+     */
+    explicit JsonSink( std::shared_ptr<Sink> _output,
+                       Severity _threshold = Severity::Verbose ) noexcept;
+
+    /**
+     * @copydoc Sink::write()
+     */
+    void write( const Entry &_entry ) noexcept override;
+
+    /**
+     * @copydoc Sink::append()
+     */
+    void append( const Entry &_entry ) noexcept override;
+
+    /**
+     * @copydoc Sink::commit()
+     */
+    void commit() noexcept override;
+
+    /**
+     * @copydoc Sink::flush()
+     */
+    void flush() noexcept override;
+
+    /**
+     * @copydoc Sink::close()
+     */
+    void close() noexcept override;
+
+  private:
+    /**
+     * @brief Member for output of the JSON lines.
+     */
+    std::shared_ptr<Sink> m_output {};
+  };
+}
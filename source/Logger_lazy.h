@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* stl header */
+#include <concepts> // std::invocable
+#include <functional> // std::invoke
+#include <type_traits>
+#include <utility> // std::move
+
+/* local header */
+#include "Logger.h"
+
+/**
+ * @brief vx (VX APPS) logger namespace.
+ */
+namespace vx::logger {
+
+  /**
+   * @brief Argument, that is computed only when the record is written.
+   * @tparam Function   Type of the callable.
+   */
+  template <typename Function>
+  struct Lazy {
+
+    /**
+     * @brief Callable, that returns the value to log.
+     */
+    Function function;
+  };
+
+  /**
+   * @brief Wrap a callable, that is invoked only when the record is written, e.g. lazy( [ & ] { return dump( request ); } ).
+   * @tparam Function   Type of the callable.
+   * @param _function   Callable, that returns the value to log.
+   * @return Lazy argument.
+   */
+  template <typename Function>
+    requires std::invocable<Function &> && ( !std::is_void_v<std::invoke_result_t<Function &>> )
+  [[nodiscard]] constexpr Lazy<Function> lazy( Function _function ) noexcept( std::is_nothrow_move_constructible_v<Function> ) {
+
+    return { std::move( _function ) };
+  }
+
+  /**
+   * @brief Logger operator << for a lazy argument.
+   * The callable is not invoked below avoidLogBelow, for records only captured by the flight recorder and for records, that the asynchronous writer would drop.
+   * @tparam Function   Type of the callable.
+   * @param _logger   Logger.
+   * @param _lazy   Lazy argument.
+   * @return Logger with output.
+   */
+  template <typename Function>
+  Logger &operator<<( Logger &_logger,
+                      Lazy<Function> _lazy ) {
+
+    if ( _logger.emitted() ) {
+
+      _logger << std::invoke( _lazy.function );
+    }
+    return _logger;
+  }
+}
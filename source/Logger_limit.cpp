@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* stl header */
+#include <algorithm> // std::find
+#include <tuple> // std::ignore
+
+/* local header */
+#include "Logger_limit.h"
+#include "Logger_sink.h"
+
+namespace vx::logger::limit {
+
+  Counter::Counter( Site &_site,
+                    Severity _severity,
+                    const std::source_location &_location ) noexcept
+    : m_site( _site ) {
+
+    Summary::instance().attach( *this, _severity, _location );
+  }
+
+  Counter::~Counter() noexcept {
+
+    Summary::instance().detach( *this );
+  }
+
+  Summary::Summary() {
+
+    /* The summary is logged up to the destructor, so the logger needs to outlive it. */
+    std::ignore = Configuration::instance();
+    std::ignore = SinkRegistry::instance();
+    m_thread = std::jthread( [ this ]( const std::stop_token &_token ) { run( _token ); } );
+  }
+
+  Summary::~Summary() noexcept {
+
+    m_thread.request_stop();
+    {
+      const std::lock_guard<std::mutex> lock( m_mutex );
+    }
+    m_condition.notify_all();
+    if ( m_thread.joinable() ) {
+
+      m_thread.join();
+    }
+  }
+
+  void Summary::setInterval( std::chrono::milliseconds _interval ) noexcept {
+
+    m_interval.store( _interval.count(), std::memory_order_relaxed );
+    {
+      const std::lock_guard<std::mutex> lock( m_mutex );
+    }
+    m_condition.notify_all();
+  }
+
+  void Summary::attach( Counter &_counter,
+                        Severity _severity,
+                        const std::source_location &_location ) noexcept {
+
+    Site &site = _counter.site();
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    try {
+
+      if ( !site.registered ) {
+
+        m_sites.push_back( &site );
+        site.registered = true;
+        site.severity = _severity;
+        site.file = _location.file_name();
+        site.function = _location.function_name();
+        site.line = _location.line();
+      }
+      m_counters.push_back( &_counter );
+    }
+    catch ( const std::bad_alloc & ) {
+
+      /* Nothing to do here, the records of this counter are not summarized. */
+    }
+  }
+
+  void Summary::detach( Counter &_counter ) noexcept {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    if ( const auto position = std::find( m_counters.begin(), m_counters.end(), &_counter ); position != m_counters.end() ) {
+
+      _counter.site().retired += _counter.suppressed();
+      *position = m_counters.back();
+      m_counters.pop_back();
+    }
+  }
+
+  void Summary::summarize() noexcept {
+
+    /**
+     * @brief Suppressed records of a call site since the last summary.
+     */
+    struct Report {
+
+      /**
+       * @brief Site of the records.
+       */
+      Site *site = nullptr;
+
+      /**
+       * @brief Number of suppressed records.
+       */
+      std::uint64_t count = 0;
+    };
+
+    std::vector<Report> reports {};
+    try {
+
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      for ( Site *site : m_sites ) {
+
+        reports.push_back( { site, site->retired } );
+      }
+      for ( const Counter *counter : m_counters ) {
+
+        const auto report = std::find_if( reports.begin(), reports.end(), [ counter ]( const Report &_report ) { return _report.site == &counter->site(); } );
+        report->count += counter->suppressed();
+      }
+      for ( Report &report : reports ) {
+
+        const std::uint64_t total = report.count;
+        report.count = total - report.site->reported;
+        report.site->reported = total;
+      }
+    }
+    catch ( const std::bad_alloc & ) {
+
+      /* Nothing to do here, the next summary contains the records. */
+      return;
+    }
+
+    /* The sites are never removed and their location is constant after the registration. */
+    for ( const Report &report : reports ) {
+
+      if ( report.count > 0 && formatted( report.site->severity ) ) {
+
+        Logger logger( report.site->severity, std::source_location::current( report.site->file, report.site->function, report.site->line ) );
+        logger << "records suppressed by rate limit" << report.count;
+      }
+    }
+  }
+
+  void Summary::run( const std::stop_token &_token ) noexcept {
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    while ( !_token.stop_requested() ) {
+
+      const std::int64_t interval = m_interval.load( std::memory_order_relaxed );
+      if ( m_condition.wait_for( lock, std::chrono::milliseconds( interval ), [ this, interval, &_token ] { return _token.stop_requested() || interval != m_interval.load( std::memory_order_relaxed ); } ) ) {
+
+        continue;
+      }
+      lock.unlock();
+      summarize();
+      lock.lock();
+    }
+    lock.unlock();
+
+    /* The last summary is written by this thread, the record buffer of the main thread is already gone. */
+    summarize();
+  }
+}
@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+/* c header */
+#include <cstdint> // std::int64_t, std::uint32_t, std::uint64_t
+
+/* stl header */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef> // std::size_t
+#include <mutex>
+#include <ratio>
+#include <string_view>
+#include <vector>
+#ifdef HAVE_JTHREAD
+  #include <thread>
+#else
+  #ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Weverything"
+  #endif
+  #include <jthread.hpp>
+  #ifdef __clang__
+    #pragma clang diagnostic pop
+  #endif
+#endif
+
+/* local header */
+#include "Logger.h"
+#include "Singleton.h"
+
+/**
+ * @brief vx (VX APPS) logger rate limit namespace.
+ */
+namespace vx::logger::limit {
+
+  /**
+   * @brief Shared state of a call site, constant initialized without a guard.
+   */
+  struct Site {
+
+    /**
+     * @brief Number of written records, only used by firstN.
+     */
+    std::atomic<std::uint64_t> written { 0 };
+
+    /**
+     * @brief Theoretical arrival time of the next record in nanoseconds, token bucket as generic cell rate algorithm.
+     */
+    std::atomic<std::int64_t> next { 0 };
+
+    /**
+     * @brief Suppressed records of exited threads, guarded by the summary.
+     */
+    std::uint64_t retired = 0;
+
+    /**
+     * @brief Suppressed records, that are already summarized, guarded by the summary.
+     */
+    std::uint64_t reported = 0;
+
+    /**
+     * @brief Is the site known to the summary, guarded by the summary.
+     */
+    bool registered = false;
+
+    /**
+     * @brief Severity of the call site, guarded by the summary.
+     */
+    Severity severity = Severity::Info;
+
+    /**
+     * @brief Source file of the call site, guarded by the summary.
+     */
+    std::string_view file {};
+
+    /**
+     * @brief Function of the call site, guarded by the summary.
+     */
+    std::string_view function {};
+
+    /**
+     * @brief Source line of the call site, guarded by the summary.
+     */
+    std::uint_least32_t line = 0;
+  };
+
+  /**
+   * @brief State of a call site in one thread, only this thread writes its counters.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Counter {
+
+  public:
+    /**
+     * @brief Constructor for Counter, registers the counter at the summary.
+     * @param _site   Shared state of the call site.
+     * @param _severity   Severity of the call site.
+     * @param _location   Source location of the call site.
+     */
+    Counter( Site &_site,
+             Severity _severity,
+             const std::source_location &_location ) noexcept;
+
+    /**
+     * @brief Default destructor for Counter, hands over the suppressed records to the site.
+     */
+    ~Counter() noexcept;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    Counter( const Counter & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    Counter( Counter && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    Counter &operator=( const Counter & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    Counter &operator=( Counter && ) = delete;
+
+    /**
+     * @brief Shared state of the call site.
+     * @return Site of the counter.
+     */
+    [[nodiscard]] inline Site &site() const noexcept { return m_site; }
+
+    /**
+     * @brief Count a hit of the call site in this thread.
+     * @return Hits before this one.
+     */
+    inline std::uint64_t hit() noexcept {
+
+      /* Only this thread writes, so there is no read-modify-write on a shared cache line. */
+      const std::uint64_t hits = m_hits.load( std::memory_order_relaxed );
+      m_hits.store( hits + 1, std::memory_order_relaxed );
+      return hits;
+    }
+
+    /**
+     * @brief Count a suppressed record.
+     * @return Always false, the record is not written.
+     */
+    inline bool skip() noexcept {
+
+      m_suppressed.store( m_suppressed.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+      return false;
+    }
+
+    /**
+     * @brief Suppressed records of this thread.
+     * @return Number of suppressed records.
+     */
+    [[nodiscard]] inline std::uint64_t suppressed() const noexcept { return m_suppressed.load( std::memory_order_relaxed ); }
+
+  private:
+    /**
+     * @brief Member for shared state of the call site.
+     */
+    Site &m_site;
+
+    /**
+     * @brief Member for hits of the call site in this thread.
+     */
+    std::atomic<std::uint64_t> m_hits { 0 };
+
+    /**
+     * @brief Member for suppressed records of the call site in this thread.
+     */
+    std::atomic<std::uint64_t> m_suppressed { 0 };
+  };
+
+  /**
+   * @brief Periodic summary of suppressed records per call site.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Summary : public Singleton<Summary> {
+
+  public:
+    /**
+     * @brief Default constructor for Summary, starts the summary thread.
+     */
+    Summary();
+
+    /**
+     * @brief Default destructor for Summary, stops the summary thread and writes the last summary.
+     */
+    ~Summary() noexcept;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    Summary( const Summary & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    Summary( Summary && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    Summary &operator=( const Summary & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    Summary &operator=( Summary && ) = delete;
+
+    /**
+     * @brief Get interval between two summaries.
+     * @return Interval between two summaries.
+     */
+    [[nodiscard]] inline std::chrono::milliseconds interval() const noexcept { return std::chrono::milliseconds( m_interval.load( std::memory_order_relaxed ) ); }
+
+    /**
+     * @brief Set interval between two summaries.
+     * @param _interval   Interval between two summaries.
+     */
+    void setInterval( std::chrono::milliseconds _interval ) noexcept;
+
+    /**
+     * @brief Register the counter of a thread.
+     * @param _counter   Counter of a call site.
+     * @param _severity   Severity of the call site.
+     * @param _location   Source location of the call site.
+     */
+    void attach( Counter &_counter,
+                 Severity _severity,
+                 const std::source_location &_location ) noexcept;
+
+    /**
+     * @brief Unregister the counter of an exiting thread.
+     * @param _counter   Counter of a call site.
+     */
+    void detach( Counter &_counter ) noexcept;
+
+    /**
+     * @brief Log the records suppressed since the last summary, one record per call site with the severity and location of the site.
+     * The summary takes the same path as the records of the site, it has no category and the sampling rate of the severity applies.
+     */
+    void summarize() noexcept;
+
+  private:
+    /**
+     * @brief Summarize every interval until stop is requested.
+     * @param _token   Stop token of the summary thread.
+     */
+    void run( const std::stop_token &_token ) noexcept;
+
+    /**
+     * @brief Member for interval between two summaries in milliseconds.
+     */
+    std::atomic<std::int64_t> m_interval { std::chrono::milliseconds( std::chrono::seconds( 10 ) ).count() };
+
+    /**
+     * @brief Member for mutex, guards the counters and sites.
+     */
+    std::mutex m_mutex {};
+
+    /**
+     * @brief Member for counters of all threads.
+     */
+    std::vector<Counter *> m_counters {};
+
+    /**
+     * @brief Member for every site with a counter.
+     */
+    std::vector<Site *> m_sites {};
+
+    /**
+     * @brief Condition member.
+     */
+    std::condition_variable m_condition {};
+
+    /**
+     * @brief Member for summary thread, needs to be the last member.
+     */
+    std::jthread m_thread {};
+  };
+
+  /**
+   * @brief Counter of a call site for the current thread.
+   * @tparam Unique   Unique type of the call site.
+   * @param _severity   Severity of the call site.
+   * @param _location   Source location of the call site.
+   * @return Counter of the current thread.
+   */
+  template <typename Unique>
+  [[nodiscard]] inline Counter &counter( [[maybe_unused]] Unique _unique,
+                                         Severity _severity,
+                                         const std::source_location &_location ) noexcept {
+
+    static constinit Site site {};
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+    thread_local Counter counter( site, _severity, _location );
+    return counter;
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+  }
+
+  /**
+   * @brief Write the first record and every n-th after it, counted per thread.
+   * @param _counter   Counter of the call site.
+   * @param _n   Write every n-th record.
+   * @return True, if the record is written - otherwise false.
+   */
+  [[nodiscard]] inline bool everyN( Counter &_counter,
+                                    std::uint64_t _n ) noexcept {
+
+    if ( const std::uint64_t hits = _counter.hit(); _n == 0 || hits % _n != 0 ) {
+
+      return _counter.skip();
+    }
+    return true;
+  }
+
+  /**
+   * @brief Write only the first n records.
+   * @param _counter   Counter of the call site.
+   * @param _n   Number of records to write.
+   * @return True, if the record is written - otherwise false.
+   */
+  [[nodiscard]] inline bool firstN( Counter &_counter,
+                                    std::uint64_t _n ) noexcept {
+
+    /* After the first n records, it is a single relaxed load. */
+    std::atomic<std::uint64_t> &written = _counter.site().written;
+    std::uint64_t current = written.load( std::memory_order_relaxed );
+    do {
+
+      if ( current >= _n ) {
+
+        return _counter.skip();
+      }
+    } while ( !written.compare_exchange_weak( current, current + 1, std::memory_order_relaxed ) );
+    return true;
+  }
+
+  /**
+   * @brief Interval of a rate.
+   * @param _perSecond   Records per second, 0 to write none.
+   * @return Interval to refill one token.
+   */
+  [[nodiscard]] constexpr std::chrono::nanoseconds interval( std::uint64_t _perSecond ) noexcept {
+
+    return _perSecond == 0 ? std::chrono::nanoseconds::max() : std::chrono::nanoseconds( static_cast<std::int64_t>( std::nano::den / _perSecond ) );
+  }
+
+  /**
+   * @brief Token bucket, a record takes one token and one token comes back every interval.
+   * @param _counter   Counter of the call site.
+   * @param _interval   Interval to refill one token, nanoseconds::max() to write none.
+   * @param _burst   Size of the bucket.
+   * @return True, if the record is written - otherwise false.
+   */
+  [[nodiscard]] inline bool tokenBucket( Counter &_counter,
+                                         std::chrono::nanoseconds _interval,
+                                         std::uint32_t _burst ) noexcept {
+
+    if ( _interval == std::chrono::nanoseconds::max() ) {
+
+      return _counter.skip();
+    }
+
+    std::atomic<std::int64_t> &next = _counter.site().next;
+    const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+    const std::int64_t interval = _interval.count();
+    const std::int64_t tolerance = interval * ( std::max<std::int64_t>( _burst, 1 ) - 1 );
+    std::int64_t current = next.load( std::memory_order_relaxed );
+    do {
+
+      if ( now < current - tolerance ) {
+
+        return _counter.skip();
+      }
+    } while ( !next.compare_exchange_weak( current, std::max( current, now ) + interval, std::memory_order_relaxed ) );
+    return true;
+  }
+}
+
+/* Rate limited records, the state is per call site. Arguments of suppressed records are not evaluated, the suppressed records are summarized periodically. */
+#define logLimited( _severity, _check, ... ) ( _severity ) < vx::logger::minimumSeverity || !vx::logger::formatted( _severity ) || !( _check ) ? static_cast<void>( 0 ) : vx::logger::Voidify() & vx::logger::Logger( _severity, logLocation() ).logger( __VA_ARGS__ )
+#define logEveryN( _severity, _n, ... ) logLimited( _severity, vx::logger::limit::everyN( vx::logger::limit::counter( [] {}, _severity, logLocation() ), _n ), __VA_ARGS__ )
+#define logFirstN( _severity, _n, ... ) logLimited( _severity, vx::logger::limit::firstN( vx::logger::limit::counter( [] {}, _severity, logLocation() ), _n ), __VA_ARGS__ )
+#define logEveryMs( _severity, _milliseconds, ... ) logLimited( _severity, vx::logger::limit::tokenBucket( vx::logger::limit::counter( [] {}, _severity, logLocation() ), std::chrono::milliseconds( _milliseconds ), 1 ), __VA_ARGS__ )
+#define logRateLimited( _severity, _perSecond, _burst, ... ) logLimited( _severity, vx::logger::limit::tokenBucket( vx::logger::limit::counter( [] {}, _severity, logLocation() ), vx::logger::limit::interval( _perSecond ), _burst ), __VA_ARGS__ )
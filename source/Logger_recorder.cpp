@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* system header */
+#ifdef _WIN32
+  #include <io.h>
+#else
+  #include <signal.h>
+  #include <unistd.h>
+#endif
+
+/* c header */
+#include <csignal>
+#include <cstring> // std::memcpy
+
+/* stl header */
+#include <algorithm>
+#include <mutex>
+
+/* local header */
+#include "Logger_recorder.h"
+
+namespace vx::logger {
+
+  namespace {
+
+    /**
+     * @brief Recorder, that is dumped by the signal handler.
+     */
+    std::atomic<const FlightRecorder *> crashRecorder { nullptr };
+
+    /**
+     * @brief Write text completely, async-signal-safe.
+     * @param _descriptor   File descriptor to write to.
+     * @param _text   Text to write.
+     */
+    void writeAll( std::int32_t _descriptor,
+                   std::string_view _text ) noexcept {
+
+      while ( !_text.empty() ) {
+
+#ifdef _WIN32
+        const auto written = ::_write( _descriptor, _text.data(), static_cast<unsigned int>( _text.size() ) );
+#else
+        const auto written = ::write( _descriptor, _text.data(), _text.size() );
+#endif
+        if ( written <= 0 ) {
+
+          return;
+        }
+        _text.remove_prefix( static_cast<std::size_t>( written ) );
+      }
+    }
+
+#ifdef _WIN32
+    /**
+     * @brief Handler of SIGSEGV before the recorder was installed.
+     */
+    void ( *previousSegmentation )( std::int32_t ) = SIG_DFL;
+
+    /**
+     * @brief Handler of SIGABRT before the recorder was installed.
+     */
+    void ( *previousAbort )( std::int32_t ) = SIG_DFL;
+
+    /**
+     * @brief Dump the flight recorder and continue with the previous handler.
+     * @param _signal   Signal number.
+     */
+    extern "C" void crashHandler( std::int32_t _signal ) {
+
+      if ( const FlightRecorder *recorder = crashRecorder.exchange( nullptr ); recorder != nullptr ) {
+
+        recorder->dump();
+      }
+      std::signal( _signal, _signal == SIGSEGV ? previousSegmentation : previousAbort );
+      std::raise( _signal );
+    }
+#else
+    /**
+     * @brief Action of SIGSEGV before the recorder was installed.
+     */
+    struct sigaction previousSegmentation {};
+
+    /**
+     * @brief Action of SIGABRT before the recorder was installed.
+     */
+    struct sigaction previousAbort {};
+
+    /**
+     * @brief Dump the flight recorder and continue with the previous action.
+     * @param _signal   Signal number.
+     * @param _info   Signal information.
+     * @param _context   User context of the signal.
+     */
+    extern "C" void crashHandler( std::int32_t _signal,
+                                  siginfo_t *_info,
+                                  void *_context ) {
+
+      if ( const FlightRecorder *recorder = crashRecorder.exchange( nullptr ); recorder != nullptr ) {
+
+        recorder->dump();
+      }
+      const struct sigaction &previous = _signal == SIGSEGV ? previousSegmentation : previousAbort;
+      ::sigaction( _signal, &previous, nullptr );
+      if ( ( previous.sa_flags & SA_SIGINFO ) != 0 ) {
+
+        previous.sa_sigaction( _signal, _info, _context );
+      }
+      else if ( previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN ) {
+
+        previous.sa_handler( _signal );
+      }
+      else {
+
+        ::raise( _signal );
+      }
+    }
+#endif
+
+    /**
+     * @brief Guards the previous handlers, install and uninstall.
+     */
+    std::mutex handlerMutex {};
+
+    /**
+     * @brief The crash handler is installed.
+     */
+    bool installed = false;
+  }
+
+  void FlightRecorder::record( std::string_view _text ) noexcept {
+
+    const std::uint64_t position = m_head.fetch_add( 1, std::memory_order_relaxed );
+    Slot &slot = m_slots[ position % capacity ];
+
+    /* Never wait: skip the record, if a writer is still busy or a newer record already owns the slot. */
+    std::uint64_t sequence = slot.sequence.load( std::memory_order_relaxed );
+    const std::uint64_t writing = position * 2 + 1;
+    do {
+
+      if ( sequence % 2 == 1 || sequence > writing ) {
+
+        return;
+      }
+    } while ( !slot.sequence.compare_exchange_weak( sequence, writing, std::memory_order_relaxed ) );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    std::size_t size = std::min( _text.size(), textSize );
+    std::memcpy( slot.text.data(), _text.data(), size );
+    if ( size < _text.size() ) {
+
+      slot.text[ size - 1 ] = '\n';
+    }
+    slot.size = static_cast<std::uint16_t>( size );
+    slot.sequence.store( writing + 1, std::memory_order_release );
+  }
+
+  void FlightRecorder::dump( std::int32_t _descriptor ) const noexcept {
+
+    writeAll( _descriptor, "----- flight recorder: last records -----\n" );
+    const std::uint64_t head = m_head.load( std::memory_order_acquire );
+    std::array<char, textSize> text {};
+    for ( std::uint64_t position = head > capacity ? head - capacity : 0; position < head; position++ ) {
+
+      const Slot &slot = m_slots[ position % capacity ];
+      const std::uint64_t sequence = slot.sequence.load( std::memory_order_acquire );
+      if ( sequence != position * 2 + 2 ) {
+
+        /* Not written yet or already overwritten. */
+        continue;
+      }
+      const std::size_t size = std::min<std::size_t>( slot.size, textSize );
+      std::memcpy( text.data(), slot.text.data(), size );
+      std::atomic_thread_fence( std::memory_order_acquire );
+      if ( slot.sequence.load( std::memory_order_relaxed ) == sequence ) {
+
+        writeAll( _descriptor, { text.data(), size } );
+      }
+    }
+    writeAll( _descriptor, "----- flight recorder: end -----\n" );
+  }
+
+  void FlightRecorder::installHandlers() noexcept {
+
+    const std::lock_guard<std::mutex> lock( handlerMutex );
+    crashRecorder.store( this, std::memory_order_release );
+    if ( installed ) {
+
+      return;
+    }
+#ifdef _WIN32
+    previousSegmentation = std::signal( SIGSEGV, crashHandler );
+    previousAbort = std::signal( SIGABRT, crashHandler );
+#else
+    struct sigaction action {};
+    action.sa_sigaction = crashHandler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset( &action.sa_mask );
+    ::sigaction( SIGSEGV, &action, &previousSegmentation );
+    ::sigaction( SIGABRT, &action, &previousAbort );
+#endif
+    installed = true;
+  }
+
+  void FlightRecorder::uninstallHandlers() noexcept {
+
+    const std::lock_guard<std::mutex> lock( handlerMutex );
+    crashRecorder.store( nullptr, std::memory_order_release );
+    if ( !installed ) {
+
+      return;
+    }
+#ifdef _WIN32
+    std::signal( SIGSEGV, previousSegmentation );
+    std::signal( SIGABRT, previousAbort );
+#else
+    ::sigaction( SIGSEGV, &previousSegmentation, nullptr );
+    ::sigaction( SIGABRT, &previousAbort, nullptr );
+#endif
+    installed = false;
+  }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+/* c header */
+#include <cstdint> // std::int32_t, std::uint16_t, std::uint64_t
+
+/* stl header */
+#include <array>
+#include <atomic>
+#include <cstddef> // std::size_t
+#include <string_view>
+
+/* local header */
+#include "Singleton.h"
+
+/**
+ * @brief vx (VX APPS) logger namespace.
+ */
+namespace vx::logger {
+
+  /**
+   * @brief Lock-free ring of the last records, including the ones below avoidLogBelow.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class FlightRecorder : public Singleton<FlightRecorder> {
+
+  public:
+    /**
+     * @brief Number of records in the ring.
+     */
+    static constexpr std::size_t capacity = 1024;
+
+    /**
+     * @brief File descriptor of stderr.
+     */
+    static constexpr std::int32_t standardError = 2;
+
+    /**
+     * @brief Capture a finished record, longer records are truncated.
+     * @param _text   Complete record including newline.
+     */
+    void record( std::string_view _text ) noexcept;
+
+    /**
+     * @brief Write the captured records from oldest to newest, async-signal-safe.
+     * @param _descriptor   File descriptor to write to.
+     */
+    void dump( std::int32_t _descriptor = standardError ) const noexcept;
+
+    /**
+     * @brief Dump the records to stderr on SIGSEGV and SIGABRT, then continue with the previous handlers.
+     */
+    void installHandlers() noexcept;
+
+    /**
+     * @brief Restore the handlers, that were installed before installHandlers().
+     */
+    static void uninstallHandlers() noexcept;
+
+  private:
+    /**
+     * @brief Maximum size of a captured record.
+     */
+    static constexpr std::size_t textSize = 240;
+
+    /**
+     * @brief Captured record, guarded by a sequence lock.
+     */
+    struct alignas( 64 ) Slot {
+
+      /**
+       * @brief Odd while written, 2 * ( position + 1 ) after the record at position is written.
+       */
+      std::atomic<std::uint64_t> sequence { 0 };
+
+      /**
+       * @brief Used size of the text.
+       */
+      std::uint16_t size = 0;
+
+      /**
+       * @brief Text of the record.
+       */
+      std::array<char, textSize> text {};
+    };
+
+    /**
+     * @brief Member for ring of records.
+     */
+    std::array<Slot, capacity> m_slots {};
+
+    /**
+     * @brief Member for next position in the ring.
+     */
+    alignas( 64 ) std::atomic<std::uint64_t> m_head { 0 };
+  };
+}
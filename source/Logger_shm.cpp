@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* system header */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* c header */
+#include <cstring> // std::memcpy
+
+/* stl header */
+#include <algorithm>
+
+/* local header */
+#include "Logger_shm.h"
+
+namespace vx::logger {
+
+  namespace {
+
+    /**
+     * @brief Layout identifier of the shared memory ("VXLOGSM1").
+     */
+    constexpr std::uint64_t layoutMagic = 0x56584c4f47534d31;
+  }
+
+  SharedRing::~SharedRing() noexcept {
+
+    close();
+  }
+
+  bool SharedRing::open( const std::string &_name ) noexcept {
+
+    close();
+    const std::int32_t descriptor = ::shm_open( _name.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR );
+    if ( descriptor < 0 ) {
+
+      return false;
+    }
+
+    /* A new shared memory is empty, zero filled slots and counters are a valid empty ring. */
+    struct stat status {};
+    bool valid = ::fstat( descriptor, &status ) == 0;
+    if ( valid && status.st_size == 0 ) {
+
+      valid = ::ftruncate( descriptor, static_cast<off_t>( mappingSize() ) ) == 0;
+    }
+    else if ( valid ) {
+
+      valid = static_cast<std::size_t>( status.st_size ) == mappingSize();
+    }
+    void *mapping = valid ? ::mmap( nullptr, mappingSize(), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0 ) : MAP_FAILED;
+    ::close( descriptor );
+    if ( mapping == MAP_FAILED ) {
+
+      return false;
+    }
+
+    auto *header = static_cast<Header *>( mapping );
+    std::uint64_t magic = 0;
+    if ( !atomic( header->magic ).compare_exchange_strong( magic, layoutMagic, std::memory_order_acq_rel ) && magic != layoutMagic ) {
+
+      ::munmap( mapping, mappingSize() );
+      return false;
+    }
+    m_header = header;
+    m_slots = reinterpret_cast<Slot *>( header + 1 );
+    return true;
+  }
+
+  void SharedRing::close() noexcept {
+
+    if ( m_header != nullptr ) {
+
+      ::munmap( m_header, mappingSize() );
+    }
+    m_header = nullptr;
+    m_slots = nullptr;
+    m_stalled = 0;
+  }
+
+  bool SharedRing::push( Severity _severity,
+                         std::string_view _text ) noexcept {
+
+    if ( m_header == nullptr ) {
+
+      return false;
+    }
+    const std::uint64_t position = atomic( m_header->head ).fetch_add( 1, std::memory_order_relaxed );
+    Slot &slot = m_slots[ position % capacity ];
+
+    /* Never wait and never retry: drop the record, if a newer record owns the slot or a writer of the last lap is still busy. */
+    /* A writer, that is busy since two laps, vanished with its process and the slot is taken over. */
+    const std::uint64_t writing = position * 2 + 1;
+    std::uint64_t sequence = atomic( slot.sequence ).load( std::memory_order_relaxed );
+    if ( sequence >= writing || ( sequence % 2 == 1 && sequence + 2 * capacity >= writing ) || !atomic( slot.sequence ).compare_exchange_strong( sequence, writing, std::memory_order_relaxed ) ) {
+
+      atomic( m_header->dropped ).fetch_add( 1, std::memory_order_relaxed );
+      return false;
+    }
+    std::atomic_thread_fence( std::memory_order_release );
+
+    const std::size_t size = std::min( _text.size(), textSize );
+    std::memcpy( slot.text.data(), _text.data(), size );
+    if ( size < _text.size() ) {
+
+      slot.text[ size - 1 ] = '\n';
+    }
+    slot.severity = static_cast<std::uint8_t>( _severity );
+    slot.size = static_cast<std::uint16_t>( size );
+
+    /* Fails only, if the slot was taken over meanwhile. */
+    std::uint64_t written = writing;
+    atomic( slot.sequence ).compare_exchange_strong( written, writing + 1, std::memory_order_release, std::memory_order_relaxed );
+    return true;
+  }
+
+  bool SharedRing::pop( Severity &_severity,
+                        std::string &_text ) {
+
+    if ( m_header == nullptr ) {
+
+      return false;
+    }
+    std::uint64_t tail = atomic( m_header->tail ).load( std::memory_order_relaxed );
+    while ( true ) {
+
+      const std::uint64_t head = atomic( m_header->head ).load( std::memory_order_acquire );
+      if ( tail >= head ) {
+
+        m_stalled = 0;
+        return false;
+      }
+      if ( head - tail > capacity ) {
+
+        atomic( m_header->lost ).fetch_add( head - capacity - tail, std::memory_order_relaxed );
+        tail = head - capacity;
+        m_stalled = 0;
+      }
+
+      Slot &slot = m_slots[ tail % capacity ];
+      const std::uint64_t expected = tail * 2 + 2;
+      const std::uint64_t sequence = atomic( slot.sequence ).load( std::memory_order_acquire );
+      if ( sequence < expected && ++m_stalled < stallLimit ) {
+
+        /* The writer is still busy, keep the position. */
+        atomic( m_header->tail ).store( tail, std::memory_order_release );
+        return false;
+      }
+
+      bool valid = false;
+      if ( sequence == expected ) {
+
+        _severity = static_cast<Severity>( std::min( slot.severity, static_cast<std::uint8_t>( Severity::Fatal ) ) );
+        _text.assign( slot.text.data(), std::min<std::size_t>( slot.size, textSize ) );
+        std::atomic_thread_fence( std::memory_order_acquire );
+        valid = atomic( slot.sequence ).load( std::memory_order_relaxed ) == expected;
+      }
+      if ( !valid ) {
+
+        /* Overwritten by a newer record or never completed. */
+        atomic( m_header->lost ).fetch_add( 1, std::memory_order_relaxed );
+      }
+      m_stalled = 0;
+      atomic( m_header->tail ).store( ++tail, std::memory_order_release );
+      if ( valid ) {
+
+        return true;
+      }
+    }
+  }
+
+  std::uint64_t SharedRing::dropped() const noexcept {
+
+    return m_header != nullptr ? atomic( m_header->dropped ).load( std::memory_order_relaxed ) : 0;
+  }
+
+  std::uint64_t SharedRing::lost() const noexcept {
+
+    return m_header != nullptr ? atomic( m_header->lost ).load( std::memory_order_relaxed ) : 0;
+  }
+
+  void SharedRing::remove( const std::string &_name ) noexcept {
+
+    ::shm_unlink( _name.c_str() );
+  }
+
+  void SharedSink::write( const Entry &_entry ) noexcept {
+
+    m_ring.push( _entry.severity, _entry.text );
+  }
+}
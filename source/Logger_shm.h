@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstdint> // std::int32_t, std::uint8_t, std::uint16_t, std::uint64_t
+
+/* stl header */
+#include <array>
+#include <atomic>
+#include <cstddef> // std::size_t
+#include <string>
+#include <string_view>
+
+/* local header */
+#include "Logger.h"
+#include "Logger_sink.h"
+
+/**
+ * @brief vx (VX APPS) logger namespace.
+ */
+namespace vx::logger {
+
+  /**
+   * @brief Ring of records in POSIX shared memory, written by any number of processes and read by one log daemon.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class SharedRing {
+
+  public:
+    /**
+     * @brief Number of records in the ring.
+     */
+    static constexpr std::size_t capacity = 4096;
+
+    /**
+     * @brief Maximum size of a record, longer records are truncated.
+     */
+    static constexpr std::size_t textSize = 500;
+
+    /**
+     * @brief Polls without progress, until the reader skips a position, whose writer vanished.
+     */
+    static constexpr std::size_t stallLimit = 64;
+
+    /**
+     * @brief Default constructor for SharedRing.
+     */
+    SharedRing() = default;
+
+    /**
+     * @brief Default destructor for SharedRing, unmaps the ring and keeps the shared memory.
+     */
+    ~SharedRing() noexcept;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    SharedRing( const SharedRing & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    SharedRing( SharedRing && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    SharedRing &operator=( const SharedRing & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    SharedRing &operator=( SharedRing && ) = delete;
+
+    /**
+     * @brief Attach to the shared memory, create it, if it does not exist.
+     * @param _name   Name of the shared memory, e.g. "/vx.logger".
+     * @return True, if the ring is mapped - otherwise false.
+     */
+    bool open( const std::string &_name ) noexcept;
+
+    /**
+     * @brief Unmap the ring.
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Is the ring mapped.
+     * @return True, if the ring is mapped - otherwise false.
+     */
+    [[nodiscard]] inline bool isOpen() const noexcept { return m_header != nullptr; }
+
+    /**
+     * @brief Write a record, wait-free and independent of the reader.
+     * @param _severity   Severity of the record.
+     * @param _text   Complete record including newline.
+     * @return True, if the record is in the ring - false, if it was dropped.
+     */
+    bool push( Severity _severity,
+               std::string_view _text ) noexcept;
+
+    /**
+     * @brief Read the next record, only one reader at a time.
+     * @param _severity   Severity of the record.
+     * @param _text   Text of the record.
+     * @return True, if a record was read - false, if there is none yet.
+     */
+    bool pop( Severity &_severity,
+              std::string &_text );
+
+    /**
+     * @brief Records, that writers had to drop, because their slot was busy.
+     * @return Number of dropped records.
+     */
+    [[nodiscard]] std::uint64_t dropped() const noexcept;
+
+    /**
+     * @brief Records, that were overwritten or never completed before the reader got them, including dropped ones.
+     * @return Number of lost records.
+     */
+    [[nodiscard]] std::uint64_t lost() const noexcept;
+
+    /**
+     * @brief Remove the shared memory, attached rings stay valid.
+     * @param _name   Name of the shared memory.
+     */
+    static void remove( const std::string &_name ) noexcept;
+
+  private:
+    /**
+     * @brief Counters of the ring, each group on its own cache line.
+     */
+    struct Header {
+
+      /**
+       * @brief Layout identifier, zero while the ring is new.
+       */
+      std::uint64_t magic;
+
+      /**
+       * @brief Next position for writers.
+       */
+      alignas( 64 ) std::uint64_t head;
+
+      /**
+       * @brief Records dropped by writers.
+       */
+      std::uint64_t dropped;
+
+      /**
+       * @brief Next position for the reader, survives a restart of the reader.
+       */
+      alignas( 64 ) std::uint64_t tail;
+
+      /**
+       * @brief Records overwritten before they were read.
+       */
+      std::uint64_t lost;
+    };
+
+    /**
+     * @brief Record in the ring, guarded by a sequence lock.
+     */
+    struct alignas( 64 ) Slot {
+
+      /**
+       * @brief Odd while written, 2 * ( position + 1 ) after the record at position is written.
+       */
+      std::uint64_t sequence;
+
+      /**
+       * @brief Severity of the record.
+       */
+      std::uint8_t severity;
+
+      /**
+       * @brief Used size of the text.
+       */
+      std::uint16_t size;
+
+      /**
+       * @brief Text of the record.
+       */
+      std::array<char, textSize> text;
+    };
+
+    /**
+     * @brief Atomic access to a counter in the shared memory.
+     * @param _value   Counter.
+     * @return Atomic reference to the counter.
+     */
+    static std::atomic_ref<std::uint64_t> atomic( std::uint64_t &_value ) noexcept { return std::atomic_ref<std::uint64_t>( _value ); }
+
+    static_assert( std::atomic_ref<std::uint64_t>::is_always_lock_free, "shared counters need lock-free atomics" );
+
+    /**
+     * @brief Size of the shared memory.
+     * @return Size of the header and the slots.
+     */
+    static constexpr std::size_t mappingSize() noexcept { return sizeof( Header ) + capacity * sizeof( Slot ); }
+
+    /**
+     * @brief Member for header of the mapping.
+     */
+    Header *m_header = nullptr;
+
+    /**
+     * @brief Member for slots of the mapping.
+     */
+    Slot *m_slots = nullptr;
+
+    /**
+     * @brief Member for polls of the reader without progress.
+     */
+    std::size_t m_stalled = 0;
+  };
+
+  /**
+   * @brief Output into a shared ring, the log daemon owns all file and syslog output.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class SharedSink : public Sink {
+
+  public:
+    /**
+     * @brief Default constructor for SharedSink.
+     * @param _threshold   Records below this severity are not written to the sink.
+     */
+    explicit SharedSink( Severity _threshold = Severity::Verbose ) noexcept
+      : Sink( _threshold ) {}
+
+    /**
+     * @brief Attach to the shared ring.
+     * @param _name   Name of the shared memory.
+     * @return True, if the ring is mapped - otherwise false.
+     */
+    inline bool open( const std::string &_name ) noexcept { return m_ring.open( _name ); }
+
+    /**
+     * @brief Write the record into the ring, never waits for the daemon.
+     * @param _entry   Record, only valid during the call.
+     */
+    void write( const Entry &_entry ) noexcept override;
+
+    /**
+     * @brief Records, that were dropped because their slot was busy.
+     * @return Number of dropped records.
+     */
+    [[nodiscard]] inline std::uint64_t dropped() const noexcept { return m_ring.dropped(); }
+
+  private:
+    /**
+     * @brief Member for shared ring.
+     */
+    SharedRing m_ring {};
+  };
+}
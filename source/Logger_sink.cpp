@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* system header */
+#ifdef _WIN32
+  #include <io.h>
+#else
+  #include <unistd.h>
+#endif
+
+/* c header */
+#include <cerrno>
+#include <cstdio> // stdout, stderr
+
+/* stl header */
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+/* local header */
+#include "Logger_sink.h"
+
+namespace vx::logger {
+
+  namespace {
+
+    /**
+     * @brief Records logged during static destruction fall back to the console.
+     */
+    std::atomic<bool> registryShutdown { false };
+  }
+
+  void writeConsole( Severity _severity,
+                     std::string_view _text ) noexcept {
+
+    /* Output of std::cout/std::cerr, that is still buffered, comes first. */
+    std::ostream &stream = _severity >= Severity::Error ? std::cerr : std::cout;
+    stream.flush();
+
+#ifdef _WIN32
+    const std::int32_t descriptor = _fileno( _severity >= Severity::Error ? stderr : stdout );
+#else
+    const std::int32_t descriptor = _severity >= Severity::Error ? STDERR_FILENO : STDOUT_FILENO;
+#endif
+    while ( !_text.empty() ) {
+
+#ifdef _WIN32
+      const auto written = ::_write( descriptor, _text.data(), static_cast<unsigned int>( _text.size() ) );
+#else
+      const auto written = ::write( descriptor, _text.data(), _text.size() );
+#endif
+      if ( written < 0 && errno == EINTR ) {
+
+        continue;
+      }
+      if ( written <= 0 ) {
+
+        /* Nothing to do here, the output is gone. */
+        return;
+      }
+      _text.remove_prefix( static_cast<std::size_t>( written ) );
+    }
+  }
+
+  ConsoleSink::ConsoleSink( Severity _threshold )
+    : Sink( _threshold ) {
+
+    m_output.reserve( batchSize + batchSize / 2 );
+    m_error.reserve( batchSize + batchSize / 2 );
+  }
+
+  void ConsoleSink::write( const Entry &_entry ) noexcept {
+
+    /* The complete record is emitted with a single system call, so lines never tear. */
+    writeConsole( _entry.severity, _entry.text );
+  }
+
+  void ConsoleSink::append( const Entry &_entry ) noexcept {
+
+    try {
+
+      /* Collect the records, so a whole batch is a single system call. */
+      ( _entry.severity >= Severity::Error ? m_error : m_output ).append( _entry.text );
+    }
+    catch ( const std::bad_alloc & ) {
+
+      commit();
+      writeConsole( _entry.severity, _entry.text );
+      return;
+    }
+    if ( m_output.size() >= batchSize || m_error.size() >= batchSize ) {
+
+      commit();
+    }
+  }
+
+  void ConsoleSink::commit() noexcept {
+
+    if ( !m_output.empty() ) {
+
+      writeConsole( Severity::Info, m_output );
+      m_output.clear();
+    }
+    if ( !m_error.empty() ) {
+
+      writeConsole( Severity::Error, m_error );
+      m_error.clear();
+    }
+  }
+
+  SinkRegistry::SinkRegistry()
+    : m_console( std::make_shared<ConsoleSink>() ) {
+
+    add( m_console );
+  }
+
+  SinkRegistry::~SinkRegistry() noexcept {
+
+    registryShutdown.store( true, std::memory_order_release );
+    flush();
+  }
+
+  bool SinkRegistry::available() noexcept {
+
+    return !registryShutdown.load( std::memory_order_acquire );
+  }
+
+  bool SinkRegistry::add( const std::shared_ptr<Sink> &_sink ) {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    Slot *free = nullptr;
+    for ( Slot &slot : m_sinks ) {
+
+      Sink *sink = slot.sink.load( std::memory_order_relaxed );
+      if ( sink == _sink.get() ) {
+
+        return true;
+      }
+      if ( sink == nullptr && free == nullptr ) {
+
+        free = &slot;
+      }
+    }
+    if ( free == nullptr ) {
+
+      return false;
+    }
+    m_owned.emplace_back( _sink );
+    free->sink.store( _sink.get(), std::memory_order_release );
+    return true;
+  }
+
+  void SinkRegistry::remove( const std::shared_ptr<Sink> &_sink ) {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    for ( Slot &slot : m_sinks ) {
+
+      if ( slot.sink.load( std::memory_order_relaxed ) != _sink.get() ) {
+
+        continue;
+      }
+      slot.sink.store( nullptr, std::memory_order_seq_cst );
+
+      /* Dispatchers, that loaded the sink before, are still writing to it. */
+      while ( slot.users.load( std::memory_order_seq_cst ) > 0 ) {
+
+        std::this_thread::yield();
+      }
+    }
+    if ( const auto owned = std::find( m_owned.begin(), m_owned.end(), _sink ); owned != m_owned.end() ) {
+
+      _sink->close();
+      m_owned.erase( owned );
+    }
+  }
+
+  Sink *SinkRegistry::acquire( Slot &_slot ) noexcept {
+
+    /* Free slots cost no write to a shared cache line. */
+    if ( _slot.sink.load( std::memory_order_relaxed ) == nullptr ) {
+
+      return nullptr;
+    }
+    _slot.users.fetch_add( 1, std::memory_order_seq_cst );
+
+    /* Either remove() sees this user or this sees the free slot. */
+    Sink *sink = _slot.sink.load( std::memory_order_seq_cst );
+    if ( sink == nullptr ) {
+
+      release( _slot );
+    }
+    return sink;
+  }
+
+  void SinkRegistry::release( Slot &_slot ) noexcept {
+
+    _slot.users.fetch_sub( 1, std::memory_order_release );
+  }
+
+  void SinkRegistry::write( const Entry &_entry ) noexcept {
+
+    for ( Slot &slot : m_sinks ) {
+
+      if ( Sink *sink = acquire( slot ); sink != nullptr ) {
+
+        if ( _entry.severity >= sink->threshold() ) {
+
+          sink->write( _entry );
+        }
+        release( slot );
+      }
+    }
+  }
+
+  void SinkRegistry::append( const Entry &_entry ) noexcept {
+
+    for ( std::size_t pos = 0; pos < maxSinks; pos++ ) {
+
+      /* A sink stays in use until the end of the batch, so it is not closed in between. */
+      Slot &slot = m_sinks[ pos ];
+      if ( m_batch[ pos ] == nullptr ) {
+
+        m_batch[ pos ] = acquire( slot );
+      }
+      if ( Sink *sink = m_batch[ pos ]; sink != nullptr && slot.sink.load( std::memory_order_relaxed ) == sink && _entry.severity >= sink->threshold() ) {
+
+        sink->append( _entry );
+      }
+    }
+  }
+
+  void SinkRegistry::commit() noexcept {
+
+    for ( std::size_t pos = 0; pos < maxSinks; pos++ ) {
+
+      if ( Sink *sink = m_batch[ pos ]; sink != nullptr ) {
+
+        sink->commit();
+        m_batch[ pos ] = nullptr;
+        release( m_sinks[ pos ] );
+      }
+    }
+  }
+
+  void SinkRegistry::flush() noexcept {
+
+    for ( Slot &slot : m_sinks ) {
+
+      if ( Sink *sink = acquire( slot ); sink != nullptr ) {
+
+        sink->flush();
+        release( slot );
+      }
+    }
+  }
+}
@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint_least32_t
+
+/* stl header */
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory> // std::shared_ptr
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* local header */
+#include "Logger.h"
+#include "Singleton.h"
+
+/**
+ * @brief vx (VX APPS) logger namespace.
+ */
+namespace vx::logger {
+
+  /**
+   * @brief Write text with a single system call to stderr for errors and stdout otherwise.
+   * @param _severity   Severity of the text.
+   * @param _text   Complete records.
+   */
+  void writeConsole( Severity _severity,
+                     std::string_view _text ) noexcept;
+
+  /**
+   * @brief Finished record with its structured parts, the views are only valid during a call of a sink.
+   */
+  struct Entry {
+
+    /**
+     * @brief Severity of the record.
+     */
+    Severity severity = Severity::Debug;
+
+    /**
+     * @brief Point in time, when the record was created.
+     */
+    std::chrono::system_clock::time_point time {};
+
+    /**
+     * @brief Source file of the record.
+     */
+    std::string_view file {};
+
+    /**
+     * @brief Source line of the record.
+     */
+    std::uint_least32_t line = 0;
+
+    /**
+     * @brief Function of the record.
+     */
+    std::string_view function {};
+
+    /**
+     * @brief Complete formatted record including header and newline.
+     */
+    std::string_view text {};
+
+    /**
+     * @brief Size of the header at the beginning of the text.
+     */
+    std::size_t headerSize = 0;
+
+    /**
+     * @brief Structured fields as JSON members, e.g. ,"user":42 - empty without fields.
+     */
+    std::string_view fields {};
+
+    /**
+     * @brief Category of the record - empty without category.
+     */
+    std::string_view category {};
+  };
+
+  /**
+   * @brief Output of formatted records.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Sink {
+
+  public:
+    /**
+     * @brief Default constructor for Sink.
+     * @param _threshold   Records below this severity are not written to the sink.
+     */
+    explicit Sink( Severity _threshold = Severity::Verbose ) noexcept
+      : m_threshold( _threshold ) {}
+
+    /**
+     * @brief Default destructor for Sink.
+     */
+    virtual ~Sink() = default;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    Sink( const Sink & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    Sink( Sink && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    Sink &operator=( const Sink & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    Sink &operator=( Sink && ) = delete;
+
+    /**
+     * @brief Get threshold.
+     * @return Records below this severity are not written to the sink.
+     */
+    [[nodiscard]] inline Severity threshold() const noexcept { return m_threshold.load( std::memory_order_relaxed ); }
+
+    /**
+     * @brief Set threshold.
+     * @param _threshold   Records below this severity are not written to the sink.
+     */
+    inline void setThreshold( Severity _threshold ) noexcept { m_threshold.store( _threshold, std::memory_order_relaxed ); }
+
+    /**
+     * @brief Write a finished record, may be called from several threads at once.
+     * @param _entry   Record, only valid during the call.
+     */
+    virtual void write( const Entry &_entry ) noexcept = 0;
+
+    /**
+     * @brief Append a record of a batch, only called by the background writer.
+     * @param _entry   Record, only valid during the call.
+     */
+    virtual void append( const Entry &_entry ) noexcept { write( _entry ); }
+
+    /**
+     * @brief End of a batch, only called by the background writer.
+     */
+    virtual void commit() noexcept { /* nothing to do */ }
+
+    /**
+     * @brief Block until every record written so far is delivered.
+     */
+    virtual void flush() noexcept { /* nothing to do */ }
+
+    /**
+     * @brief The sink was removed from the registry and no record is written to it anymore, release resources.
+     */
+    virtual void close() noexcept { flush(); }
+
+  private:
+    /**
+     * @brief Member for threshold.
+     */
+    std::atomic<Severity> m_threshold { Severity::Verbose };
+  };
+
+  /**
+   * @brief Console output, stderr for errors and stdout otherwise.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class ConsoleSink : public Sink {
+
+  public:
+    /**
+     * @brief Default constructor for ConsoleSink.
+     * @param _threshold   Records below this severity are not written to the sink.
+     */
+    explicit ConsoleSink( Severity _threshold = Severity::Verbose );
+
+    /**
+     * @copydoc Sink::write()
+     */
+    void write( const Entry &_entry ) noexcept override;
+
+    /**
+     * @copydoc Sink::append()
+     */
+    void append( const Entry &_entry ) noexcept override;
+
+    /**
+     * @copydoc Sink::commit()
+     */
+    void commit() noexcept override;
+
+  private:
+    /**
+     * @brief Batch size, when the collected records are written.
+     */
+    static constexpr std::size_t batchSize = 64 * 1024;
+
+    /**
+     * @brief Member for collected records for stdout.
+     */
+    std::string m_output {};
+
+    /**
+     * @brief Member for collected records for stderr.
+     */
+    std::string m_error {};
+  };
+
+  /**
+   * @brief Registry of sinks, every record is formatted once and dispatched to every sink, whose threshold admits it.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class SinkRegistry : public Singleton<SinkRegistry> {
+
+  public:
+    /**
+     * @brief Default constructor for SinkRegistry, registers the console sink.
+     */
+    SinkRegistry();
+
+    /**
+     * @brief Default destructor for SinkRegistry, flushes every sink.
+     */
+    ~SinkRegistry() noexcept;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    SinkRegistry( const SinkRegistry & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    SinkRegistry( SinkRegistry && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    SinkRegistry &operator=( const SinkRegistry & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    SinkRegistry &operator=( SinkRegistry && ) = delete;
+
+    /**
+     * @brief Is the registry still dispatching records?
+     * @return False, if the registry is already shut down - otherwise true.
+     */
+    [[nodiscard]] static bool available() noexcept;
+
+    /**
+     * @brief Get the default console sink, e.g. to change the threshold.
+     * @return Console sink.
+     */
+    [[nodiscard]] inline std::shared_ptr<ConsoleSink> console() const noexcept { return m_console; }
+
+    /**
+     * @brief Add a sink.
+     * @param _sink   Sink to add.
+     * @return True, if the sink is registered - false, if there are already too many sinks.
+     * @note The registry keeps the sink alive, until it is removed.
+     */
+    bool add( const std::shared_ptr<Sink> &_sink );
+
+    /**
+     * @brief Remove a sink and close it, after every record, that is currently written to it, is finished.
+     * @param _sink   Sink to remove.
+     * @note Blocks until the background writer committed its current batch, it must not be called from a sink.
+     */
+    void remove( const std::shared_ptr<Sink> &_sink );
+
+    /**
+     * @brief Write a finished record to every sink, whose threshold admits it.
+     * @param _entry   Record.
+     */
+    void write( const Entry &_entry ) noexcept;
+
+    /**
+     * @brief Append a record of a batch to every sink, whose threshold admits it, only called by the background writer.
+     * @param _entry   Record.
+     */
+    void append( const Entry &_entry ) noexcept;
+
+    /**
+     * @brief End of a batch for every sink, that received records, only called by the background writer.
+     */
+    void commit() noexcept;
+
+    /**
+     * @brief Block until every sink delivered its records.
+     */
+    void flush() noexcept;
+
+  private:
+    /**
+     * @brief Maximum number of sinks.
+     */
+    static constexpr std::size_t maxSinks = 8;
+
+    /**
+     * @brief Registered sink, that is only removed, when no dispatcher uses it.
+     */
+    struct alignas( 64 ) Slot {
+
+      /**
+       * @brief Registered sink, nullptr for a free slot.
+       */
+      std::atomic<Sink *> sink { nullptr };
+
+      /**
+       * @brief Number of dispatchers, that might use the sink.
+       */
+      std::atomic<std::size_t> users { 0 };
+    };
+
+    /**
+     * @brief Start to use the sink of a slot, it is not closed until it is released.
+     * @param _slot   Slot of the sink.
+     * @return Sink of the slot or nullptr, if the slot is free.
+     */
+    static Sink *acquire( Slot &_slot ) noexcept;
+
+    /**
+     * @brief Stop to use the sink of a slot.
+     * @param _slot   Slot of the sink.
+     */
+    static void release( Slot &_slot ) noexcept;
+
+    /**
+     * @brief Member for registered sinks.
+     */
+    std::array<Slot, maxSinks> m_sinks {};
+
+    /**
+     * @brief Member for sinks by slot, that are used by the current batch of the background writer.
+     */
+    std::array<Sink *, maxSinks> m_batch {};
+
+    /**
+     * @brief Member for mutex, only used to change the sinks.
+     */
+    std::mutex m_mutex {};
+
+    /**
+     * @brief Member for registered sinks, that are kept alive.
+     */
+    std::vector<std::shared_ptr<Sink>> m_owned {};
+
+    /**
+     * @brief Member for console sink.
+     */
+    std::shared_ptr<ConsoleSink> m_console {};
+  };
+}
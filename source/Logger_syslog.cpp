@@ -0,0 +1,488 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* system header */
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* c header */
+#include <cerrno>
+#include <climits> // HOST_NAME_MAX
+
+/* stl header */
+#include <algorithm> // std::min
+#include <array>
+#include <charconv> // std::to_chars
+#include <chrono>
+#include <cstring> // std::memcpy
+
+/* local header */
+#include "Logger_json.h"
+#include "Logger_syslog.h"
+#include "Timestamp.h"
+
+namespace vx::logger {
+
+  namespace {
+
+#ifdef MSG_NOSIGNAL
+    /**
+     * @brief Flags of every send, a vanished syslog daemon must not raise SIGPIPE.
+     */
+    constexpr std::int32_t sendFlags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else
+    constexpr std::int32_t sendFlags = MSG_DONTWAIT;
+#endif
+
+    /**
+     * @brief Private enterprise number reserved for documentation (RFC 5612), used as SD-ID of the source location and category.
+     */
+    constexpr std::string_view sourceId = "[vx@32473";
+
+    /**
+     * @brief Datagram of the current thread, reused for every record.
+     * @return Datagram buffer.
+     */
+    std::string &datagramBuffer() noexcept {
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+      thread_local std::string datagram {};
+      return datagram;
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+    }
+
+    /**
+     * @brief Map a logger severity to a syslog severity.
+     * @param _severity   Severity of the record.
+     * @return Syslog severity from 0 (emergency) to 7 (debug).
+     */
+    std::int32_t level( Severity _severity ) noexcept {
+
+      switch ( _severity ) {
+
+        case Severity::Verbose:
+        case Severity::Debug:
+          return 7;
+        case Severity::Info:
+          return 6;
+        case Severity::Warning:
+          return 4;
+        case Severity::Error:
+          return 3;
+        case Severity::Fatal:
+          return 2;
+      }
+      return 6;
+    }
+
+    /**
+     * @brief Append a header field, that only allows printable US-ASCII without spaces.
+     * @param _output   Output to append to.
+     * @param _name   Value of the field, '-' if empty.
+     * @param _maxSize   Maximum size of the field.
+     */
+    void appendName( std::string &_output,
+                     std::string_view _name,
+                     std::size_t _maxSize ) {
+
+      if ( _name.empty() ) {
+
+        _output += '-';
+        return;
+      }
+      for ( const char character : _name.substr( 0, _maxSize ) ) {
+
+        _output += ( character > ' ' && character < 0x7f ) ? character : '_';
+      }
+    }
+
+    /**
+     * @brief Append a structured data parameter, '"', '\' and ']' are escaped.
+     * @param _output   Output to append to.
+     * @param _name   Name of the parameter.
+     * @param _value   Value of the parameter.
+     */
+    void appendParameter( std::string &_output,
+                          std::string_view _name,
+                          std::string_view _value ) {
+
+      _output += ' ';
+      _output += _name;
+      _output += "=\"";
+      for ( const char character : _value ) {
+
+        if ( character == '"' || character == '\\' || character == ']' ) {
+
+          _output += '\\';
+        }
+        _output += character;
+      }
+      _output += '"';
+    }
+
+    /**
+     * @brief Address of a unix socket.
+     * @param _path   Path of the socket.
+     * @param _address   Address to fill.
+     * @return True, if the path fits into the address - otherwise false.
+     */
+    bool socketAddress( const std::string &_path,
+                        sockaddr_un &_address ) noexcept {
+
+      _address = {};
+      _address.sun_family = AF_UNIX;
+      if ( _path.empty() || _path.size() >= sizeof( _address.sun_path ) ) {
+
+        return false;
+      }
+      std::memcpy( _address.sun_path, _path.data(), _path.size() );
+      return true;
+    }
+
+    /**
+     * @brief Has the syslog daemon closed its socket, e.g. for a restart.
+     * @param _error   Error of the system call.
+     * @return True, if connecting again might help - otherwise false.
+     */
+    bool disconnected( std::int32_t _error ) noexcept {
+
+      return _error == ECONNREFUSED || _error == ENOTCONN;
+    }
+  }
+
+  SyslogSink::SyslogSink( std::string_view _appName,
+                          Facility _facility,
+                          Severity _threshold )
+    : Sink( _threshold ),
+      m_facility( static_cast<std::int32_t>( _facility ) * 8 ) {
+
+    /* Header fields are constant for the process, so they are prepared once. */
+    std::array<char, HOST_NAME_MAX + 1> host {};
+    if ( ::gethostname( host.data(), host.size() - 1 ) != 0 ) {
+
+      host[ 0 ] = '\0';
+    }
+
+    constexpr std::size_t maxHostName = 255;
+    constexpr std::size_t maxAppName = 48;
+    m_origin += ' ';
+    appendName( m_origin, host.data(), maxHostName );
+    m_origin += ' ';
+    appendName( m_origin, _appName, maxAppName );
+    m_origin += ' ';
+    json::appendNumber( m_origin, ::getpid() );
+    m_origin += " - ";
+  }
+
+  SyslogSink::~SyslogSink() noexcept {
+
+    if ( m_socket >= 0 ) {
+
+      ::close( m_socket );
+    }
+  }
+
+  bool SyslogSink::open( const std::string &_path ) noexcept {
+
+    close();
+
+    sockaddr_un address {};
+    if ( !socketAddress( _path, address ) ) {
+
+      return false;
+    }
+
+    const std::int32_t descriptor = ::socket( AF_UNIX, SOCK_DGRAM, 0 );
+    if ( descriptor < 0 ) {
+
+      return false;
+    }
+    ::fcntl( descriptor, F_SETFD, FD_CLOEXEC );
+    ::fcntl( descriptor, F_SETFL, ::fcntl( descriptor, F_GETFL ) | O_NONBLOCK );
+    if ( ::connect( descriptor, reinterpret_cast<const sockaddr *>( &address ), sizeof( address ) ) != 0 ) {
+
+      ::close( descriptor );
+      return false;
+    }
+
+    try {
+
+      m_path = _path;
+    }
+    catch ( const std::bad_alloc & ) {
+
+      /* The sink works, it only cannot reconnect. */
+    }
+    m_socket = descriptor;
+    return true;
+  }
+
+  void SyslogSink::write( const Entry &_entry ) noexcept {
+
+    /* The warning about dropped records comes first, while the socket is full the record is dropped as well. */
+    if ( !report() ) {
+
+      m_dropped.fetch_add( 1, std::memory_order_relaxed );
+      return;
+    }
+
+    try {
+
+      std::string &datagram = datagramBuffer();
+      datagram.clear();
+      appendDatagram( datagram, _entry );
+      if ( send( datagram ) ) {
+
+        return;
+      }
+    }
+    catch ( const std::bad_alloc & ) {
+
+      /* Nothing to do here, the record is lost. */
+    }
+    m_dropped.fetch_add( 1, std::memory_order_relaxed );
+  }
+
+  void SyslogSink::append( const Entry &_entry ) noexcept {
+
+    try {
+
+      if ( m_ends.size() >= batchSize ) {
+
+        commit();
+      }
+      appendDatagram( m_batch, _entry );
+      m_ends.push_back( m_batch.size() );
+    }
+    catch ( const std::bad_alloc & ) {
+
+      commit();
+      write( _entry );
+    }
+  }
+
+  void SyslogSink::commit() noexcept {
+
+    const std::size_t count = m_ends.size();
+    if ( count == 0 ) {
+
+      return;
+    }
+
+    std::size_t sent = 0;
+    if ( report() ) {
+
+#ifdef __linux__
+      /* The whole batch is a single system call, unless the socket fills up in between. */
+      std::array<mmsghdr, batchSize> messages {};
+      std::array<iovec, batchSize> vectors {};
+      std::size_t begin = 0;
+      for ( std::size_t pos = 0; pos < count; pos++ ) {
+
+        vectors.at( pos ) = { m_batch.data() + begin, m_ends[ pos ] - begin };
+        messages.at( pos ).msg_hdr.msg_iov = &vectors.at( pos );
+        messages.at( pos ).msg_hdr.msg_iovlen = 1;
+        begin = m_ends[ pos ];
+      }
+
+      bool retried = false;
+      while ( sent < count ) {
+
+        const std::int32_t result = ::sendmmsg( m_socket, messages.data() + sent, static_cast<unsigned int>( count - sent ), sendFlags );
+        if ( result > 0 ) {
+
+          sent += static_cast<std::size_t>( result );
+          continue;
+        }
+        if ( result < 0 && errno == EINTR ) {
+
+          continue;
+        }
+        if ( result < 0 && disconnected( errno ) && !retried && reconnect() ) {
+
+          retried = true;
+          continue;
+        }
+        break;
+      }
+#else
+      std::size_t begin = 0;
+      for ( ; sent < count; sent++ ) {
+
+        if ( !send( { m_batch.data() + begin, m_ends[ sent ] - begin } ) ) {
+
+          break;
+        }
+        begin = m_ends[ sent ];
+      }
+#endif
+    }
+
+    m_dropped.fetch_add( count - sent, std::memory_order_relaxed );
+    m_batch.clear();
+    m_ends.clear();
+  }
+
+  void SyslogSink::close() noexcept {
+
+    commit();
+    if ( m_socket >= 0 ) {
+
+      ::close( m_socket );
+      m_socket = -1;
+    }
+  }
+
+  void SyslogSink::appendDatagram( std::string &_output,
+                                   const Entry &_entry ) const {
+
+    const std::size_t begin = _output.size();
+
+    _output += '<';
+    json::appendNumber( _output, m_facility + level( _entry.severity ) );
+    _output += ">1 ";
+    timestamp::Iso8601Buffer timestamp {};
+    _output += timestamp::iso8601( _entry.time, timestamp::Precision::MicroSeconds, timestamp );
+    _output += m_origin;
+
+    if ( _entry.file.empty() && _entry.category.empty() ) {
+
+      _output += '-';
+    }
+    else {
+
+      _output += sourceId;
+      if ( !_entry.file.empty() ) {
+
+        std::array<char, 16> line {};
+        const char *end = std::to_chars( line.data(), line.data() + line.size(), _entry.line ).ptr;
+        appendParameter( _output, "file", _entry.file );
+        appendParameter( _output, "line", { line.data(), static_cast<std::size_t>( end - line.data() ) } );
+        appendParameter( _output, "function", _entry.function );
+      }
+      if ( !_entry.category.empty() ) {
+
+        appendParameter( _output, "category", _entry.category );
+      }
+      _output += ']';
+    }
+
+    std::string_view message = _entry.text.substr( std::min( _entry.headerSize, _entry.text.size() ) );
+    while ( !message.empty() && ( message.back() == '\n' || message.back() == ' ' ) ) {
+
+      message.remove_suffix( 1 );
+    }
+    if ( !message.empty() ) {
+
+      _output += ' ';
+      _output += message;
+    }
+
+    if ( _output.size() - begin > datagramSize ) {
+
+      _output.resize( begin + datagramSize );
+    }
+  }
+
+  bool SyslogSink::send( std::string_view _datagram ) noexcept {
+
+    bool retried = false;
+    while ( ::send( m_socket, _datagram.data(), _datagram.size(), sendFlags ) < 0 ) {
+
+      if ( errno == EINTR ) {
+
+        continue;
+      }
+      if ( disconnected( errno ) && !retried && reconnect() ) {
+
+        retried = true;
+        continue;
+      }
+
+      /* EAGAIN: the socket of the syslog daemon is full, waiting would stall the logging threads. */
+      return false;
+    }
+    return true;
+  }
+
+  bool SyslogSink::reconnect() noexcept {
+
+    const std::unique_lock lock( m_reconnect, std::try_to_lock );
+    sockaddr_un address {};
+    if ( !lock.owns_lock() || m_socket < 0 || !socketAddress( m_path, address ) ) {
+
+      return false;
+    }
+    return ::connect( m_socket, reinterpret_cast<const sockaddr *>( &address ), sizeof( address ) ) == 0;
+  }
+
+  bool SyslogSink::report() noexcept {
+
+    std::uint64_t reported = m_reported.load( std::memory_order_relaxed );
+    const std::uint64_t dropped = m_dropped.load( std::memory_order_relaxed );
+    if ( dropped == reported || !m_reported.compare_exchange_strong( reported, dropped, std::memory_order_relaxed ) ) {
+
+      /* Nothing to report or another thread reports. */
+      return true;
+    }
+
+    try {
+
+      std::string text = "dropped ";
+      json::appendNumber( text, dropped - reported );
+      text += " records, the syslog socket was full";
+
+      Entry entry {};
+      entry.severity = Severity::Warning;
+      entry.time = std::chrono::system_clock::now();
+      entry.text = text;
+
+      std::string datagram {};
+      appendDatagram( datagram, entry );
+      if ( send( datagram ) ) {
+
+        return true;
+      }
+    }
+    catch ( const std::bad_alloc & ) {
+
+      /* Report again with the next record. */
+    }
+    m_reported.fetch_sub( dropped - reported, std::memory_order_relaxed );
+    return false;
+  }
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstdint> // std::int32_t, std::uint8_t, std::uint64_t
+
+/* stl header */
+#include <atomic>
+#include <cstddef> // std::size_t
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* local header */
+#include "Logger.h"
+#include "Logger_sink.h"
+
+/**
+ * @brief vx (VX APPS) logger namespace.
+ */
+namespace vx::logger {
+
+  /**
+   * @brief Syslog facility of the records.
+   */
+  enum class Facility : std::uint8_t {
+
+    Kernel = 0,  /**< Kernel messages */
+    User = 1,    /**< User-level messages */
+    Mail = 2,    /**< Mail system */
+    Daemon = 3,  /**< System daemons */
+    Auth = 4,    /**< Security/authorization messages */
+    Local0 = 16, /**< Local use 0 */
+    Local1 = 17, /**< Local use 1 */
+    Local2 = 18, /**< Local use 2 */
+    Local3 = 19, /**< Local use 3 */
+    Local4 = 20, /**< Local use 4 */
+    Local5 = 21, /**< Local use 5 */
+    Local6 = 22, /**< Local use 6 */
+    Local7 = 23  /**< Local use 7 */
+  };
+
+  /**
+   * @brief RFC 5424 records as datagrams to a unix socket, e.g. /dev/log.
+   * @note The sink never waits for the syslog daemon: while its socket buffer is full, records are dropped and counted.
+   * The next record, that is delivered, is preceded by a warning with the number of dropped records.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class SyslogSink : public Sink {
+
+  public:
+    /**
+     * @brief Maximum size of a datagram, longer records are truncated.
+     */
+    static constexpr std::size_t datagramSize = 8192;
+
+    /**
+     * @brief Maximum records of a batch, that are sent with a single system call.
+     */
+    static constexpr std::size_t batchSize = 64;
+
+    /**
+     * @brief Default constructor for SyslogSink.
+     * @param _appName   APP-NAME of the records, e.g. the name of the program.
+     * @param _facility   Facility of the records.
+     * @param _threshold   Records below this severity are not written to the sink.
+     */
+    explicit SyslogSink( std::string_view _appName = {},
+                         Facility _facility = Facility::User,
+                         Severity _threshold = Severity::Verbose );
+
+    /**
+     * @brief Default destructor for SyslogSink, closes the socket.
+     */
+    ~SyslogSink() noexcept override;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    SyslogSink( const SyslogSink & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    SyslogSink( SyslogSink && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    SyslogSink &operator=( const SyslogSink & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    SyslogSink &operator=( SyslogSink && ) = delete;
+
+    /**
+     * @brief Connect to the socket of the syslog daemon, before the sink is added to the registry.
+     * @param _path   Path of the unix datagram socket.
+     * @return True, if the socket is connected - otherwise false.
+     */
+    bool open( const std::string &_path = "/dev/log" ) noexcept;
+
+    /**
+     * @brief Is the socket connected.
+     * @return True, if the socket is connected - otherwise false.
+     */
+    [[nodiscard]] inline bool isOpen() const noexcept { return m_socket >= 0; }
+
+    /**
+     * @copydoc Sink::write()
+     */
+    void write( const Entry &_entry ) noexcept override;
+
+    /**
+     * @copydoc Sink::append()
+     */
+    void append( const Entry &_entry ) noexcept override;
+
+    /**
+     * @brief Send the batch with as few system calls as possible.
+     */
+    void commit() noexcept override;
+
+    /**
+     * @brief Send the batch and close the socket.
+     */
+    void close() noexcept override;
+
+    /**
+     * @brief Records, that were dropped, because the socket was full or not connected.
+     * @return Number of dropped records.
+     */
+    [[nodiscard]] inline std::uint64_t dropped() const noexcept { return m_dropped.load( std::memory_order_relaxed ); }
+
+  private:
+    /**
+     * @brief Append a record as RFC 5424 datagram.
+     * @param _output   Output to append to.
+     * @param _entry   Record.
+     */
+    void appendDatagram( std::string &_output,
+                         const Entry &_entry ) const;
+
+    /**
+     * @brief Send a datagram without waiting.
+     * @param _datagram   Complete datagram.
+     * @return True, if the datagram was sent - otherwise false.
+     */
+    bool send( std::string_view _datagram ) noexcept;
+
+    /**
+     * @brief Connect the socket again, after the syslog daemon was restarted.
+     * @return True, if the socket is connected - otherwise false.
+     */
+    bool reconnect() noexcept;
+
+    /**
+     * @brief Send a warning about dropped records, that was not sent yet.
+     * @return True, if no warning is outstanding - otherwise false.
+     */
+    bool report() noexcept;
+
+    /**
+     * @brief Member for PRI offset of the facility.
+     */
+    std::int32_t m_facility = 8;
+
+    /**
+     * @brief Member for HOSTNAME, APP-NAME, PROCID and MSGID between timestamp and structured data.
+     */
+    std::string m_origin {};
+
+    /**
+     * @brief Member for path of the socket.
+     */
+    std::string m_path {};
+
+    /**
+     * @brief Member for socket descriptor.
+     */
+    std::int32_t m_socket = -1;
+
+    /**
+     * @brief Member for mutex, only one thread reconnects.
+     */
+    std::mutex m_reconnect {};
+
+    /**
+     * @brief Member for datagrams of the batch.
+     */
+    std::string m_batch {};
+
+    /**
+     * @brief Member for end of every datagram in the batch.
+     */
+    std::vector<std::size_t> m_ends {};
+
+    /**
+     * @brief Member for dropped records.
+     */
+    std::atomic<std::uint64_t> m_dropped { 0 };
+
+    /**
+     * @brief Member for dropped records, that were reported by a warning.
+     */
+    std::atomic<std::uint64_t> m_reported { 0 };
+  };
+}
@@ -28,82 +28,140 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+/* c header */
+#include <cstdint> // std::int64_t
+#include <cstring> // std::memcpy
+#include <ctime> // std::strftime
+
 /* stl header */
+#include <algorithm>
 #include <chrono>
-#include <iomanip>
-#include <iostream>
-#include <sstream>
+#include <limits>
 
 /* local header */
 #include "Cpp23.h"
-#include "Logger.h"
 #include "Timestamp.h"
 
 namespace vx::timestamp {
 
-  /* get a precise timestamp as a string */
-  std::string iso8601( Precision _precision ) {
-
-    struct std::tm currentLocalTime {};
-
-    const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
-    const std::time_t nowAsTimeT = std::chrono::system_clock::to_time_t( now );
+  namespace {
+
+    /**
+     * @brief Local time of the last second, that was formatted by this thread.
+     */
+    struct Cache {
+
+      /**
+       * @brief Second since epoch.
+       */
+      std::time_t seconds = std::numeric_limits<std::time_t>::min();
+
+      /**
+       * @brief Date and time as 'Y-m-dThh:mm:ss'.
+       */
+      std::array<char, 32> date {};
+
+      /**
+       * @brief Used size of the date.
+       */
+      std::size_t dateSize = 0;
+
+      /**
+       * @brief Offset to UTC as '+hh:mm'.
+       */
+      std::array<char, 16> offset {};
+
+      /**
+       * @brief Used size of the offset.
+       */
+      std::size_t offsetSize = 0;
+    };
+
+    /**
+     * @brief Update the cache for a second since epoch.
+     * @param _cache   Cache to update.
+     * @param _seconds   Second since epoch.
+     */
+    void update( Cache &_cache,
+                 std::time_t _seconds ) noexcept {
+
+      struct std::tm currentLocalTime {};
 
 #ifdef _WIN32
-    localtime_s( &currentLocalTime, &nowAsTimeT );
+      localtime_s( &currentLocalTime, &_seconds );
 #else
-    localtime_r( &nowAsTimeT, &currentLocalTime );
+      localtime_r( &_seconds, &currentLocalTime );
 #endif
 
-    std::stringstream nowSs {};
-    nowSs << std::put_time( &currentLocalTime, "%Y-%m-%dT%T" );
-    switch ( _precision ) {
-
-      case Precision::Seconds:
-        break;
-      case Precision::MilliSeconds: {
+      _cache.dateSize = std::strftime( _cache.date.data(), _cache.date.size(), "%Y-%m-%dT%T", &currentLocalTime );
 
-        const auto nowMilli = std::chrono::duration_cast<std::chrono::milliseconds>( now.time_since_epoch() ) % std::milli::den;
-        nowSs << '.' << std::setfill( '0' ) << std::setw( std::to_underlying( _precision ) );
-        nowSs << nowMilli.count();
-        break;
-      }
-      case Precision::MicroSeconds: {
+      std::array<char, 16> offset {};
+      const std::size_t offsetSize = std::strftime( offset.data(), offset.size(), "%z", &currentLocalTime );
+      if ( offsetSize == 5 ) {
 
-        const auto nowMicro = std::chrono::duration_cast<std::chrono::microseconds>( now.time_since_epoch() ) % std::micro::den;
-        nowSs << '.' << std::setfill( '0' ) << std::setw( std::to_underlying( _precision ) );
-        nowSs << nowMicro.count();
-        break;
+        /* +hhmm -> +hh:mm */
+        std::memcpy( _cache.offset.data(), offset.data(), 3 );
+        _cache.offset[ 3 ] = ':';
+        std::memcpy( _cache.offset.data() + 4, offset.data() + 3, 2 );
+        _cache.offsetSize = 6;
       }
-      case Precision::NanoSeconds: {
+      else {
 
-        const auto nowNano = std::chrono::duration_cast<std::chrono::nanoseconds>( now.time_since_epoch() ) % std::nano::den;
-        nowSs << '.' << std::setfill( '0' ) << std::setw( std::to_underlying( _precision ) );
-        nowSs << nowNano.count();
-        break;
+        std::memcpy( _cache.offset.data(), offset.data(), offsetSize );
+        _cache.offsetSize = offsetSize;
       }
+      _cache.seconds = _seconds;
     }
+  }
 
-    std::stringstream offset {};
-    offset << std::put_time( &currentLocalTime, "%z" );
-    if ( offset.peek() != decltype( offset )::traits_type::eof() ) {
+  /* get a precise timestamp as a string */
+  std::string iso8601( Precision _precision ) {
 
-      offset.seekp( -2, std::ios_base::end );
-      offset << ':';
-      offset.seekp( 0, std::ios_base::end );
-      offset << '0';
-    }
+    return iso8601( std::chrono::system_clock::now(), _precision );
+  }
 
-    std::string result {};
-    try {
+  std::string iso8601( const std::chrono::system_clock::time_point &_timePoint,
+                       Precision _precision ) {
 
-      nowSs << offset.str();
-      result = nowSs.str();
+    Iso8601Buffer buffer {};
+    return std::string( iso8601( _timePoint, _precision, buffer ) );
+  }
+
+  std::string_view iso8601( const std::chrono::system_clock::time_point &_timePoint,
+                            Precision _precision,
+                            Iso8601Buffer &_buffer ) noexcept {
+
+    thread_local Cache cache {};
+
+    const std::time_t seconds = std::chrono::system_clock::to_time_t( _timePoint );
+    if ( seconds != cache.seconds ) {
+
+      update( cache, seconds );
     }
-    catch ( const std::exception &_exception ) {
 
-      logFatal() << _exception.what();
+    char *position = std::copy_n( cache.date.data(), cache.dateSize, _buffer.data() );
+    if ( const std::int32_t digits = std::to_underlying( _precision ); digits > 0 ) {
+
+      constexpr std::int64_t nanoPerSecond = std::nano::den;
+      std::int64_t fraction = std::chrono::duration_cast<std::chrono::nanoseconds>( _timePoint.time_since_epoch() ).count() % nanoPerSecond;
+      if ( fraction < 0 ) {
+
+        fraction += nanoPerSecond;
+      }
+      for ( std::int32_t unused = digits; unused < std::to_underlying( Precision::NanoSeconds ); unused++ ) {
+
+        fraction /= 10;
+      }
+
+      *position++ = '.';
+      for ( std::int32_t digit = digits - 1; digit >= 0; digit-- ) {
+
+        position[ digit ] = static_cast<char>( '0' + fraction % 10 );
+        fraction /= 10;
+      }
+      position += digits;
     }
-    return result;
+    position = std::copy_n( cache.offset.data(), cache.offsetSize, position );
+    return { _buffer.data(), static_cast<std::size_t>( position - _buffer.data() ) };
   }
 }
@@ -31,7 +31,10 @@
 #pragma once
 
 /* stl header */
+#include <array>
+#include <chrono>
 #include <string>
+#include <string_view>
 
 /**
  * @brief vx (VX APPS) timestamp namespace.
@@ -49,6 +52,11 @@ namespace vx::timestamp {
     NanoSeconds = 9   /**< std::chrono::nanoseconds */
   };
 
+  /**
+   * @brief Buffer, that is large enough for every timestamp.
+   */
+  using Iso8601Buffer = std::array<char, 64>;
+
   /**
    * @brief Create thread-safe timestamp.
    * @param _precision   Precision of decimal fraction of a second.
@@ -56,4 +64,26 @@ namespace vx::timestamp {
    * @note https://www.w3.org/TR/NOTE-datetime
    */
   [[nodiscard]] std::string iso8601( Precision _precision = Precision::Seconds );
+
+  /**
+   * @brief Create thread-safe timestamp for a given point in time.
+   * @param _timePoint   Point in time.
+   * @param _precision   Precision of decimal fraction of a second.
+   * @return Timestamp as 'Y-m-dThh:mm:ss.xxxxxxT'
+   * @note https://www.w3.org/TR/NOTE-datetime
+   */
+  [[nodiscard]] std::string iso8601( const std::chrono::system_clock::time_point &_timePoint,
+                                     Precision _precision = Precision::Seconds );
+
+  /**
+   * @brief Create thread-safe timestamp for a given point in time without heap allocation.
+   * @param _timePoint   Point in time.
+   * @param _precision   Precision of decimal fraction of a second.
+   * @param _buffer   Buffer, that receives the timestamp.
+   * @return Timestamp as 'Y-m-dThh:mm:ss.xxxxxxT', that points into the buffer.
+   * @note The local time is only calculated once per second and thread.
+   */
+  [[nodiscard]] std::string_view iso8601( const std::chrono::system_clock::time_point &_timePoint,
+                                          Precision _precision,
+                                          Iso8601Buffer &_buffer ) noexcept;
 }
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* stl header */
+#include <atomic>
+#include <cstddef> // std::size_t
+#include <memory> // std::unique_ptr
+#include <utility> // std::move
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief Template for bounded lock-free multi-producer multi-consumer queue.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   * @tparam T   Type.
+   * @note https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+   */
+  template <typename T>
+  class BoundedQueue {
+
+  public:
+    /**
+     * @brief Default constructor for BoundedQueue.
+     * @param _capacity   Minimum capacity, rounded up to the next power of two.
+     */
+    explicit BoundedQueue( std::size_t _capacity )
+      : m_mask( roundUp( _capacity ) - 1 ),
+        m_cells( std::make_unique<Cell[]>( m_mask + 1 ) ) {
+
+      for ( std::size_t pos = 0; pos <= m_mask; pos++ ) {
+
+        m_cells[ pos ].sequence.store( pos, std::memory_order_relaxed );
+      }
+    }
+
+    /**
+     * @brief Default destructor for BoundedQueue.
+     */
+    ~BoundedQueue() = default;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    BoundedQueue( const BoundedQueue & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    BoundedQueue( BoundedQueue && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    BoundedQueue &operator=( const BoundedQueue & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    BoundedQueue &operator=( BoundedQueue && ) = delete;
+
+    /**
+     * @brief Try to push an item to the queue.
+     * @param _item   Item to add.
+     * @return True, if the item was added - false, if the queue is full.
+     */
+    bool tryPush( T &&_item ) noexcept {
+
+      std::size_t position = 0;
+      return tryPush( std::move( _item ), position );
+    }
+
+    /**
+     * @brief Try to push an item to the queue and get its position.
+     * @param _item   Item to add.
+     * @param _position   Position of the item, it is taken after every item with a lower position.
+     * @return True, if the item was added - false, if the queue is full.
+     */
+    bool tryPush( T &&_item,
+                  std::size_t &_position ) noexcept {
+
+      Cell *cell = nullptr;
+      std::size_t position = m_enqueue.load( std::memory_order_relaxed );
+      while ( true ) {
+
+        cell = &m_cells[ position & m_mask ];
+        const std::size_t sequence = cell->sequence.load( std::memory_order_acquire );
+        const auto difference = static_cast<std::ptrdiff_t>( sequence ) - static_cast<std::ptrdiff_t>( position );
+        if ( difference == 0 ) {
+
+          if ( m_enqueue.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) ) {
+
+            break;
+          }
+        }
+        else if ( difference < 0 ) {
+
+          return false;
+        }
+        else {
+
+          position = m_enqueue.load( std::memory_order_relaxed );
+        }
+      }
+      cell->data = std::move( _item );
+      cell->sequence.store( position + 1, std::memory_order_release );
+      _position = position;
+      return true;
+    }
+
+    /**
+     * @brief Try to pop an item from the queue.
+     * @param _item   Item to fill.
+     * @return True, if an item was taken - false, if the queue is empty.
+     */
+    bool tryPop( T &_item ) noexcept {
+
+      Cell *cell = nullptr;
+      std::size_t position = m_dequeue.load( std::memory_order_relaxed );
+      while ( true ) {
+
+        cell = &m_cells[ position & m_mask ];
+        const std::size_t sequence = cell->sequence.load( std::memory_order_acquire );
+        const auto difference = static_cast<std::ptrdiff_t>( sequence ) - static_cast<std::ptrdiff_t>( position + 1 );
+        if ( difference == 0 ) {
+
+          if ( m_dequeue.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) ) {
+
+            break;
+          }
+        }
+        else if ( difference < 0 ) {
+
+          return false;
+        }
+        else {
+
+          position = m_dequeue.load( std::memory_order_relaxed );
+        }
+      }
+      _item = std::move( cell->data );
+      cell->sequence.store( position + m_mask + 1, std::memory_order_release );
+      return true;
+    }
+
+    /**
+     * @brief Check if the queue is empty.
+     * @return True, it the queue is empty - otherwise false.
+     * @note Only a snapshot, when other threads are pushing or popping.
+     */
+    [[nodiscard]] bool empty() const noexcept {
+
+      const std::size_t position = m_dequeue.load( std::memory_order_acquire );
+      return static_cast<std::ptrdiff_t>( m_cells[ position & m_mask ].sequence.load( std::memory_order_acquire ) ) - static_cast<std::ptrdiff_t>( position + 1 ) < 0;
+    }
+
+    /**
+     * @brief Check if the queue is full.
+     * @return True, it the queue is full - otherwise false.
+     * @note Only a snapshot, when other threads are pushing or popping.
+     */
+    [[nodiscard]] bool full() const noexcept {
+
+      const std::size_t position = m_enqueue.load( std::memory_order_acquire );
+      return static_cast<std::ptrdiff_t>( m_cells[ position & m_mask ].sequence.load( std::memory_order_acquire ) ) - static_cast<std::ptrdiff_t>( position ) < 0;
+    }
+
+    /**
+     * @brief Number of items, that are pushed or are being pushed.
+     * @return Position of the next item to push.
+     */
+    [[nodiscard]] std::size_t pushed() const noexcept { return m_enqueue.load( std::memory_order_acquire ); }
+
+    /**
+     * @brief Number of items, that are taken.
+     * @return Position of the next item to take.
+     */
+    [[nodiscard]] std::size_t taken() const noexcept { return m_dequeue.load( std::memory_order_acquire ); }
+
+    /**
+     * @brief Return the capacity of the queue.
+     * @return The queue capacity.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_mask + 1; }
+
+  private:
+    /**
+     * @brief Size of a cache line to avoid false sharing.
+     */
+    static constexpr std::size_t cacheLine = 64;
+
+    /**
+     * @brief Single queue cell.
+     */
+    struct Cell {
+
+      /**
+       * @brief Sequence to synchronize producer and consumer.
+       */
+      std::atomic<std::size_t> sequence { 0 };
+
+      /**
+       * @brief The stored item.
+       */
+      T data {};
+    };
+
+    /**
+     * @brief Round up to the next power of two.
+     * @param _value   Value to round up.
+     * @return The next power of two.
+     */
+    static constexpr std::size_t roundUp( std::size_t _value ) noexcept {
+
+      std::size_t result = 2;
+      while ( result < _value ) {
+
+        result <<= 1;
+      }
+      return result;
+    }
+
+    /**
+     * @brief Member for capacity mask.
+     */
+    std::size_t m_mask = 0;
+
+    /**
+     * @brief Member for cells.
+     */
+    std::unique_ptr<Cell[]> m_cells {};
+
+    /**
+     * @brief Member for enqueue position.
+     */
+    alignas( cacheLine ) std::atomic<std::size_t> m_enqueue { 0 };
+
+    /**
+     * @brief Member for dequeue position.
+     */
+    alignas( cacheLine ) std::atomic<std::size_t> m_dequeue { 0 };
+  };
+}
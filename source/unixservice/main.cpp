@@ -29,6 +29,7 @@
  */
 
 /* c header */
+#include <csignal>
 #include <cstdint>
 
 /* system header */
@@ -37,13 +38,83 @@
 #include <unistd.h>
 
 /* stl header */
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <memory>
 #include <string>
+#include <thread>
+
+/* local header */
+#include "Logger_shm.h"
+#include "Logger_syslog.h"
 
 constexpr auto DAEMON_NAME = "Demo";
 
+/* Shared memory, the logging processes write their records to */
+constexpr auto LOG_RING_NAME = "/vx.logger";
+
+namespace {
+
+  /**
+   * @brief Cleared by SIGTERM and SIGINT to stop the service.
+   */
+  volatile std::sig_atomic_t running = 1;
+
+  /**
+   * @brief Stop the service loop.
+   */
+  extern "C" void stopHandler( std::int32_t ) {
+
+    running = 0;
+  }
+
+  /**
+   * @brief Map a logger severity to a syslog priority.
+   * @param _severity   Severity of the record.
+   * @return Syslog priority.
+   */
+  std::int32_t priority( vx::logger::Severity _severity ) noexcept {
+
+    switch ( _severity ) {
+
+      case vx::logger::Severity::Verbose:
+      case vx::logger::Severity::Debug:
+        return LOG_DEBUG;
+      case vx::logger::Severity::Info:
+        return LOG_INFO;
+      case vx::logger::Severity::Warning:
+        return LOG_WARNING;
+      case vx::logger::Severity::Error:
+        return LOG_ERR;
+      case vx::logger::Severity::Fatal:
+        return LOG_CRIT;
+    }
+    return LOG_INFO;
+  }
+
+  /**
+   * @brief Forward a record to the syslog sink, ::syslog() only while the sink is not connected.
+   * @param _sink   Syslog sink.
+   * @param _severity   Severity of the record.
+   * @param _text   Text of the record without newline.
+   */
+  void forward( vx::logger::SyslogSink &_sink,
+                vx::logger::Severity _severity,
+                const std::string &_text ) noexcept {
+
+    if ( _sink.isOpen() ) {
+
+      _sink.write( vx::logger::Entry { _severity, std::chrono::system_clock::now(), {}, 0, {}, _text, 0, {} } );
+    }
+    else {
+
+      ::syslog( priority( _severity ), "%s", _text.c_str() );
+    }
+  }
+}
+
 /* For security purposes, we don't allow any arguments to be passed into the daemon */
 std::int32_t main() {
 
@@ -151,6 +222,46 @@ std::int32_t main() {
 
   // SERVICE START
   /* Daemon-specific intialization should go here */
+  std::signal( SIGTERM, stopHandler );
+  std::signal( SIGINT, stopHandler );
+
+  /* Records of the daemon itself and of the logging processes share one RFC 5424 stream to /dev/log */
+  /* The socket is never waited for: while syslog is busy records are dropped and their number is reported */
+  const auto syslogSink = std::make_shared<vx::logger::SyslogSink>( DAEMON_NAME );
+  if ( vx::logger::SinkRegistry &sinks = vx::logger::SinkRegistry::instance(); syslogSink->open() ) {
+
+    /* The standard file descriptors are closed, the console has no reader */
+    sinks.remove( sinks.console() );
+    sinks.add( syslogSink );
+  }
+
+  /* The daemon owns all log output: drain the ring of the logging processes into syslog */
+  /* The ring is never removed, so writers keep writing while the daemon restarts and it continues where it stopped */
+  vx::logger::SharedRing ring {};
+  if ( !ring.open( LOG_RING_NAME ) ) {
+
+    ::syslog( LOG_ERR, "Could not open log ring %s", LOG_RING_NAME );
+  }
+  std::uint64_t lost = ring.lost();
+  vx::logger::Severity severity = vx::logger::Severity::Info;
+  std::string text {};
+  while ( running != 0 && ring.isOpen() ) {
+
+    while ( ring.pop( severity, text ) ) {
+
+      while ( !text.empty() && text.back() == '\n' ) {
+
+        text.pop_back();
+      }
+      forward( *syslogSink, severity, text );
+    }
+    if ( const std::uint64_t current = ring.lost(); current != lost ) {
+
+      forward( *syslogSink, vx::logger::Severity::Warning, "Lost " + std::to_string( current - lost ) + " log records" );
+      lost = current;
+    }
+    std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+  }
 
   // SERVICE END
 
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <string>
+#include <thread>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <BoundedQueue.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( BoundedQueue, Capacity ) {
+
+    const BoundedQueue<std::int32_t> queue( 5 );
+    EXPECT_EQ( queue.capacity(), 8 );
+    EXPECT_TRUE( queue.empty() );
+  }
+
+  TEST( BoundedQueue, Order ) {
+
+    BoundedQueue<std::string> queue( 4 );
+    EXPECT_TRUE( queue.tryPush( "first" ) );
+    EXPECT_TRUE( queue.tryPush( "second" ) );
+    EXPECT_FALSE( queue.empty() );
+
+    std::string item {};
+    EXPECT_TRUE( queue.tryPop( item ) );
+    EXPECT_EQ( item, "first" );
+    EXPECT_TRUE( queue.tryPop( item ) );
+    EXPECT_EQ( item, "second" );
+    EXPECT_FALSE( queue.tryPop( item ) );
+    EXPECT_TRUE( queue.empty() );
+  }
+
+  TEST( BoundedQueue, Full ) {
+
+    BoundedQueue<std::int32_t> queue( 2 );
+    EXPECT_TRUE( queue.tryPush( 1 ) );
+    EXPECT_FALSE( queue.full() );
+    EXPECT_TRUE( queue.tryPush( 2 ) );
+    EXPECT_TRUE( queue.full() );
+    EXPECT_FALSE( queue.tryPush( 3 ) );
+
+    std::int32_t item = 0;
+    EXPECT_TRUE( queue.tryPop( item ) );
+    EXPECT_FALSE( queue.full() );
+    EXPECT_TRUE( queue.tryPush( 3 ) );
+  }
+
+  TEST( BoundedQueue, Positions ) {
+
+    BoundedQueue<std::int32_t> queue( 4 );
+    std::size_t position = 0;
+    EXPECT_TRUE( queue.tryPush( 1, position ) );
+    EXPECT_EQ( position, 0 );
+    EXPECT_TRUE( queue.tryPush( 2, position ) );
+    EXPECT_EQ( position, 1 );
+    EXPECT_EQ( queue.pushed(), 2 );
+    EXPECT_EQ( queue.taken(), 0 );
+
+    std::int32_t item = 0;
+    EXPECT_TRUE( queue.tryPop( item ) );
+    EXPECT_EQ( queue.taken(), 1 );
+  }
+
+  TEST( BoundedQueue, MultiProducer ) {
+
+    constexpr std::int32_t producers = 4;
+    constexpr std::int32_t items = 10000;
+    BoundedQueue<std::int32_t> queue( 64 );
+
+    std::vector<std::thread> threads {};
+    for ( std::int32_t producer = 0; producer < producers; producer++ ) {
+
+      threads.emplace_back( [ &queue ] {
+        for ( std::int32_t value = 1; value <= items; value++ ) {
+
+          while ( !queue.tryPush( std::int32_t { value } ) ) {
+
+            std::this_thread::yield();
+          }
+        }
+      } );
+    }
+
+    std::int64_t sum = 0;
+    std::int32_t received = 0;
+    std::int32_t item = 0;
+    while ( received < producers * items ) {
+
+      if ( queue.tryPop( item ) ) {
+
+        sum += item;
+        received++;
+      }
+    }
+    for ( auto &thread : threads ) {
+
+      thread.join();
+    }
+    EXPECT_EQ( sum, static_cast<std::int64_t>( producers ) * items * ( items + 1 ) / 2 );
+    EXPECT_TRUE( queue.empty() );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
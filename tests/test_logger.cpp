@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* system header */
+#ifndef _WIN32
+  #include <signal.h>
+#endif
+
+/* c header */
+#include <csignal>
+#include <cstddef> // std::byte
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <any>
+#include <array>
+#include <atomic>
+#include <charconv> // std::from_chars
+#include <forward_list>
+#include <limits>
+#include <map>
+#include <ranges>
+#include <span>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility> // std::integer_sequence
+#include <variant>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger.h>
+#include <Logger_any.h>
+#include <Logger_container.h>
+
+/* local header */
+#include "test_logger_helper.h"
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+using vx::test::lines;
+
+namespace {
+
+  /**
+   * @brief Types, that are registered for std::any at runtime.
+   */
+  template <std::int32_t N>
+  struct Tag {};
+
+  /**
+   * @brief Register the visitors of Tag<0> up to Tag<N - 1>.
+   * @return True, if all visitors are registered - otherwise false.
+   */
+  template <std::int32_t... N>
+  bool registerTags( [[maybe_unused]] std::integer_sequence<std::int32_t, N...> _sequence ) {
+
+    return ( vx::logger::registerVisitor<Tag<N>>( []( vx::logger::Logger &_logger, [[maybe_unused]] const Tag<N> &_tag ) { _logger.stream() << "tag" << N; } ) && ... );
+  }
+
+  /**
+   * @brief Type, that logs while it is logged.
+   */
+  struct Nested {};
+
+  vx::logger::Logger &operator<<( vx::logger::Logger &_logger,
+                                  [[maybe_unused]] Nested _nested ) {
+
+    logInfo() << "inner";
+    _logger.stream() << "outer";
+    return _logger.maybeSpace();
+  }
+}
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( Logger, Simple ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    logInfo() << "answer" << 42;
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 1 );
+    EXPECT_NE( output[ 0 ].find( "[INFO]" ), std::string::npos );
+    EXPECT_NE( output[ 0 ].find( "test_logger.cpp:" ), std::string::npos );
+    EXPECT_NE( output[ 0 ].find( " \"answer\" 42 " ), std::string::npos );
+  }
+
+  TEST( Logger, Header ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    logWarning() << "header";
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 1 );
+    ASSERT_GT( output[ 0 ].size(), 26 );
+    EXPECT_EQ( output[ 0 ][ 4 ], '-' );
+    EXPECT_EQ( output[ 0 ][ 10 ], 'T' );
+    EXPECT_EQ( output[ 0 ][ 19 ], '.' );
+    EXPECT_NE( output[ 0 ].find( " \x1b[33;1m[WARNING]\x1b[0m test_logger.cpp:" ), std::string::npos );
+    EXPECT_NE( output[ 0 ].find( " TestBody \"header\" " ), std::string::npos );
+  }
+
+  TEST( Logger, Format ) {
+
+    using namespace std::literals;
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    logInfo( "{} took {} ms", "parse"sv, 42 );
+    logInfo( "plain" );
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 2 );
+    EXPECT_TRUE( output[ 0 ].ends_with( " parse took 42 ms" ) );
+    EXPECT_TRUE( output[ 1 ].ends_with( " plain" ) );
+  }
+
+  TEST( Logger, Numbers ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    logInfo() << -42 << std::uint32_t( 7 ) << std::numeric_limits<std::size_t>::max();
+    logInfo() << 0.1 << 3.14f << 100000.0 << 1e16 << 1e17 << 0.0001 << 1e-5 << 123456789.0f;
+    logInfo() << -0.0 << std::numeric_limits<double>::infinity() << std::numeric_limits<double>::denorm_min();
+    logInfo() << 1.0 / 3.0;
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 4 );
+    EXPECT_TRUE( output[ 0 ].ends_with( " -42 7 " + std::to_string( std::numeric_limits<std::size_t>::max() ) + ' ' ) );
+    EXPECT_TRUE( output[ 1 ].ends_with( " 0.1 3.14 100000 10000000000000000 1e+17 0.0001 1e-05 123456792 " ) );
+    EXPECT_TRUE( output[ 2 ].ends_with( " -0 inf 5e-324 " ) );
+
+    /* Shortest, but still reads back to the same value. */
+    const std::string third = output[ 3 ].substr( output[ 3 ].rfind( ' ', output[ 3 ].size() - 2 ) + 1 );
+    double value = 0;
+    std::from_chars( third.data(), third.data() + third.size(), value );
+    EXPECT_EQ( value, 1.0 / 3.0 );
+  }
+
+  TEST( Logger, Disabled ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Info );
+
+    std::int32_t evaluated = 0;
+    testing::internal::CaptureStdout();
+    logDebug() << ++evaluated;
+    logInfo() << ++evaluated;
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    EXPECT_EQ( evaluated, 1 );
+    EXPECT_EQ( output.size(), 1 );
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+  }
+
+  TEST( Logger, Container ) {
+
+    using namespace std::literals;
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    logInfo() << std::vector { 1, 2, 3 } << std::vector<int> {};
+    logInfo() << std::map<int, std::string> { { 3, "abc" }, { 1, "d" } };
+    logInfo() << std::tuple { 1, "abc"s, "def"sv };
+    logInfo() << std::variant<int, double>( 2.5 ) << "after";
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 4 );
+    EXPECT_TRUE( output[ 0 ].ends_with( " std::vector<int> {1, 2, 3} std::vector<int> {} " ) );
+    EXPECT_TRUE( output[ 1 ].ends_with( " std::map<int, std::string> {{1, \"d\"}, {3, \"abc\"}} " ) );
+    EXPECT_TRUE( output[ 2 ].ends_with( " std::tuple<int, std::string, std::string_view> {1, \"abc\", \"def\"sv} " ) );
+    EXPECT_TRUE( output[ 3 ].ends_with( " std::variant<int, double> 2.5 \"after\" " ) );
+  }
+
+  TEST( Logger, Elided ) {
+
+    logger::Configuration &configuration = logger::Configuration::instance();
+    configuration.setAvoidLogBelow( logger::Severity::Verbose );
+    configuration.setMaxElements( 3 );
+
+    const std::vector<int> values( 1000, 7 );
+    const std::array bytes { std::byte { 0x01 }, std::byte { 0xab }, std::byte { 0xff } };
+    testing::internal::CaptureStdout();
+    logInfo() << values;
+    logInfo() << std::span( values ).first( 2 ) << std::span( bytes );
+    logInfo() << std::views::iota( 0, 10 );
+    logInfo() << std::views::iota( 0 ) << std::forward_list { 1, 2, 3, 4 };
+    configuration.setMaxElements( 0 );
+    configuration.setMaxRecordSize( 1 );
+    logInfo() << values;
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 5 );
+    EXPECT_TRUE( output[ 0 ].ends_with( " std::vector<int> {7, 7, 7, ... 997 more} " ) );
+    EXPECT_TRUE( output[ 1 ].ends_with( " std::span<int> {7, 7} std::span<std::byte> {01, ab, ff} " ) );
+    EXPECT_TRUE( output[ 2 ].ends_with( " {0, 1, 2, ... 7 more} " ) );
+    EXPECT_TRUE( output[ 3 ].ends_with( " {0, 1, 2, ... more} {1, 2, 3, ... more} " ) ) << output[ 3 ];
+    EXPECT_TRUE( output[ 4 ].ends_with( " std::vector<int> {... 1000 more} " ) );
+
+    configuration.setMaxElements( 256 );
+    configuration.setMaxRecordSize( 64 * 1024 );
+  }
+
+  TEST( Logger, Any ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    /* Register while another thread logs std::any values. */
+    std::thread registering( [] { EXPECT_TRUE( registerTags( std::make_integer_sequence<std::int32_t, 64> {} ) ); } );
+    testing::internal::CaptureStdout();
+    for ( std::int32_t i = 0; i < 100; i++ ) {
+
+      logVerbose() << std::any( 42 ) << std::any( Tag<7> {} );
+    }
+    registering.join();
+    logInfo() << std::any( 42 ) << std::any( Tag<63> {} ) << std::any( Tag<64> {} );
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 101 );
+    EXPECT_TRUE( output[ 100 ].ends_with( " 42 tag63 unregistered: (anonymous namespace)::Tag<64> " ) );
+  }
+
+  TEST( Logger, Reconfigure ) {
+
+    logger::Configuration &configuration = logger::Configuration::instance();
+    configuration.setAvoidLogBelow( logger::Severity::Verbose );
+
+    constexpr std::int32_t threads = 8;
+    constexpr std::int32_t records = 2000;
+
+    /* Space and quotes change together, a record never sees only one of them. */
+    std::atomic<bool> running { true };
+    std::thread reconfigure( [ &configuration, &running ] {
+      bool enable = false;
+      for ( std::int32_t i = 0; running && i < 1000; i++ ) {
+
+        configuration.update( [ enable ]( logger::Settings &_settings ) noexcept {
+          _settings.autoSpace = enable;
+          _settings.autoQuotes = enable;
+        } );
+        configuration.setMaxElements( enable ? 256 : 128 );
+        enable = !enable;
+      }
+    } );
+    testing::internal::CaptureStdout();
+    std::vector<std::thread> logging {};
+    for ( std::int32_t i = 0; i < threads; i++ ) {
+
+      logging.emplace_back( [] {
+        for ( std::int32_t j = 0; j < records; j++ ) {
+
+          logInfo() << "value" << 42;
+        }
+      } );
+    }
+    for ( std::thread &thread : logging ) {
+
+      thread.join();
+    }
+    running = false;
+    reconfigure.join();
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    configuration.update( []( logger::Settings &_settings ) noexcept {
+      _settings.autoSpace = true;
+      _settings.autoQuotes = true;
+      _settings.maxElements = 256;
+    } );
+
+    ASSERT_EQ( output.size(), threads * records );
+    for ( const std::string &line : output ) {
+
+      EXPECT_TRUE( line.ends_with( " \"value\" 42 " ) || line.ends_with( " value42" ) ) << line;
+    }
+  }
+
+  TEST( Logger, UpdateSideEffects ) {
+
+    logger::Configuration &configuration = logger::Configuration::instance();
+    configuration.setAvoidLogBelow( logger::Severity::Verbose );
+
+    /* Async changed by update is applied like with setAsync, pending records are written when it ends. */
+    testing::internal::CaptureStdout();
+    configuration.update( []( logger::Settings &_settings ) noexcept { _settings.async = true; } );
+    EXPECT_TRUE( configuration.async() );
+    logInfo() << "queued";
+    configuration.update( []( logger::Settings &_settings ) noexcept { _settings.async = false; } );
+    EXPECT_FALSE( configuration.async() );
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 1 );
+    EXPECT_TRUE( output[ 0 ].ends_with( " \"queued\" " ) );
+
+    configuration.update( []( logger::Settings &_settings ) noexcept { _settings.flightRecorder = true; } );
+    EXPECT_TRUE( configuration.flightRecorder() );
+    configuration.setFlightRecorder( false );
+    EXPECT_FALSE( configuration.flightRecorder() );
+#ifndef _WIN32
+    /* Disabling the flight recorder restores the crash handlers. */
+    struct sigaction current {};
+    ::sigaction( SIGSEGV, nullptr, &current );
+    EXPECT_EQ( current.sa_handler, SIG_DFL );
+#endif
+  }
+
+  TEST( Logger, Nested ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    logInfo() << "before" << Nested {} << "after";
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 2 );
+    EXPECT_NE( output[ 0 ].find( " \"inner\" " ), std::string::npos );
+    EXPECT_NE( output[ 1 ].find( " \"before\" outer \"after\" " ), std::string::npos );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstdint> // std::int32_t
+#include <cstdio> // std::remove
+
+/* stl header */
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger_binary.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerBinary, Decode ) {
+
+    using namespace std::literals;
+
+    constexpr auto filename = "test_logger_binary.bin";
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    EXPECT_TRUE( logger::binary::open( filename ) );
+
+    constexpr std::int32_t answer = 42;
+    constexpr double half = 0.5;
+    logBinary( logger::Severity::Info, "answer", answer, half, true );
+    std::thread thread( [] { logBinary( logger::Severity::Error, "thread"s, "view"sv, static_cast<std::int8_t>( 'x' ) ); } );
+    thread.join();
+    logBinary( logger::Severity::Debug, "last" );
+    logger::binary::close();
+
+    std::ifstream input( filename, std::ios::in | std::ios::binary );
+    std::ostringstream output {};
+    EXPECT_TRUE( logger::binary::decode( input, output ) );
+    input.close();
+    std::ignore = std::remove( filename );
+
+    std::istringstream lines( output.str() );
+    std::string line {};
+    EXPECT_TRUE( std::getline( lines, line ) );
+    EXPECT_NE( line.find( "[INFO]" ), std::string::npos );
+    EXPECT_NE( line.find( "test_logger_binary.cpp:" ), std::string::npos );
+    EXPECT_NE( line.find( " \"answer\" 42 0.5 true " ), std::string::npos );
+    EXPECT_TRUE( std::getline( lines, line ) );
+    EXPECT_NE( line.find( "[ERROR]" ), std::string::npos );
+    EXPECT_NE( line.find( " \"thread\" \"view\"sv 'x' " ), std::string::npos );
+    EXPECT_TRUE( std::getline( lines, line ) );
+    EXPECT_NE( line.find( "[DEBUG]" ), std::string::npos );
+    EXPECT_NE( line.find( " \"last\" " ), std::string::npos );
+    EXPECT_FALSE( std::getline( lines, line ) );
+  }
+
+  TEST( LoggerBinary, Invalid ) {
+
+    std::istringstream input( "not a binary log" );
+    std::ostringstream output {};
+    EXPECT_FALSE( logger::binary::decode( input, output ) );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
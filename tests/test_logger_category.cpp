@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger_category.h>
+
+/* local header */
+#include "test_logger_helper.h"
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+using vx::test::lines;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerCategory, Inherit ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Warning );
+
+    testing::internal::CaptureStdout();
+    logInfoIn( "db" ) << "global";
+    logger::Categories::instance().setLevel( "net", logger::Severity::Debug );
+    logDebugIn( "net" ) << "parent";
+    logDebugIn( "net.serial" ) << "child";
+    logVerboseIn( "net.serial" ) << "verbose";
+    logInfoIn( "network" ) << "sibling";
+    logInfoIn( "net.serial", "{} bytes", 42 );
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 3 );
+    EXPECT_TRUE( output[ 0 ].ends_with( " [net] \"parent\" " ) );
+    EXPECT_TRUE( output[ 1 ].ends_with( " [net.serial] \"child\" " ) );
+    EXPECT_TRUE( output[ 2 ].ends_with( " [net.serial] 42 bytes" ) );
+  }
+
+  TEST( LoggerCategory, Override ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Warning );
+    logger::Categories &categories = logger::Categories::instance();
+
+    /* Cached call site, the level changes afterwards. */
+    const auto serial = [] { logDebugIn( "disk.serial" ) << "serial"; };
+
+    testing::internal::CaptureStdout();
+    serial();
+    categories.setLevel( "disk", logger::Severity::Verbose );
+    serial();
+    categories.setLevel( "disk.serial", logger::Severity::Error );
+    serial();
+    categories.resetLevel( "disk.serial" );
+    serial();
+    categories.resetLevel( "disk" );
+    serial();
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    EXPECT_EQ( output.size(), 2 );
+  }
+
+  TEST( LoggerCategory, Global ) {
+
+    logger::Configuration &configuration = logger::Configuration::instance();
+    configuration.setAvoidLogBelow( logger::Severity::Warning );
+    const logger::Category &cache = logger::category<"cache.lru">();
+    EXPECT_EQ( &cache, &logger::Categories::instance().category( "cache.lru" ) );
+    EXPECT_EQ( cache.level(), logger::Severity::Warning );
+
+    /* Inherited levels follow avoidLogBelow without reading the settings on every record. */
+    testing::internal::CaptureStdout();
+    logInfoIn( "cache.lru" ) << "hidden";
+    configuration.setAvoidLogBelow( logger::Severity::Info );
+    logInfoIn( "cache.lru" ) << "shown";
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 1 );
+    EXPECT_TRUE( output[ 0 ].ends_with( " [cache.lru] \"shown\" " ) );
+    EXPECT_EQ( cache.level(), logger::Severity::Info );
+    EXPECT_EQ( cache.threshold(), logger::Severity::Info );
+
+    configuration.setAvoidLogBelow( logger::Severity::Warning );
+    EXPECT_EQ( cache.threshold(), logger::Severity::Warning );
+  }
+
+  TEST( LoggerCategory, Concurrent ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Warning );
+    logger::Categories &categories = logger::Categories::instance();
+
+    std::atomic<bool> running { true };
+    std::thread logging( [ &running ] {
+      while ( running ) {
+
+        logVerboseIn( "bus.serial" ) << "verbose";
+      }
+    } );
+    testing::internal::CaptureStdout();
+    for ( std::int32_t i = 0; i < 1000; i++ ) {
+
+      categories.setLevel( "bus", i % 2 == 0 ? logger::Severity::Verbose : logger::Severity::Fatal );
+    }
+    categories.setLevel( "bus", logger::Severity::Fatal );
+    running = false;
+    logging.join();
+    testing::internal::GetCapturedStdout();
+    EXPECT_EQ( categories.category( "bus.serial" ).level(), logger::Severity::Fatal );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
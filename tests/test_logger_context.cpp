@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger_context.h>
+#include <Logger_json.h>
+
+/* local header */
+#include "test_logger_helper.h"
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+using vx::test::lines;
+using vx::test::MemorySink;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerContext, Scopes ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    const std::string request = "a1b2";
+    testing::internal::CaptureStdout();
+    logInfo() << "none";
+    {
+      const logger::Context requestScope( "request", request );
+      logInfo() << "outer";
+      {
+        const logger::Context tenantScope( "tenant", 7 );
+        logInfo() << "inner";
+
+        /* Other threads have their own context. */
+        std::thread( [] { logInfo() << "thread"; } ).join();
+      }
+      logInfo() << "popped";
+    }
+    logInfo() << "none";
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 6 );
+    EXPECT_TRUE( output[ 0 ].ends_with( " TestBody \"none\" " ) );
+    EXPECT_TRUE( output[ 1 ].ends_with( " TestBody [request=a1b2] \"outer\" " ) );
+    EXPECT_TRUE( output[ 2 ].ends_with( " TestBody [request=a1b2 tenant=7] \"inner\" " ) );
+    EXPECT_TRUE( output[ 3 ].ends_with( " \"thread\" " ) );
+    EXPECT_EQ( output[ 3 ].find( "request" ), std::string::npos );
+    EXPECT_TRUE( output[ 4 ].ends_with( " TestBody [request=a1b2] \"popped\" " ) );
+    EXPECT_TRUE( output[ 5 ].ends_with( " TestBody \"none\" " ) );
+  }
+
+  TEST( LoggerContext, Async ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    logger::SinkRegistry &sinks = logger::SinkRegistry::instance();
+    const auto memory = std::make_shared<MemorySink>();
+    const auto json = std::make_shared<logger::JsonSink>( memory );
+    EXPECT_TRUE( sinks.add( json ) );
+
+    testing::internal::CaptureStdout();
+    logger::Configuration::instance().setAsync( true );
+    {
+      const logger::Context requestScope( "request", "a1b2" );
+      const logger::Context tenantScope( "tenant", 7 );
+      logInfo() << "async";
+    }
+    logger::Configuration::instance().setAsync( false );
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    sinks.remove( json );
+
+    ASSERT_EQ( output.size(), 1 );
+    EXPECT_TRUE( output[ 0 ].ends_with( " TestBody [request=a1b2 tenant=7] \"async\" " ) );
+
+    const std::vector records = memory->records();
+    ASSERT_EQ( records.size(), 1 );
+    EXPECT_TRUE( records[ 0 ].ends_with( ",\"message\":\"\\\"async\\\"\",\"request\":\"a1b2\",\"tenant\":7}\n" ) );
+  }
+
+  TEST( LoggerContext, Types ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    logger::SinkRegistry &sinks = logger::SinkRegistry::instance();
+    const auto memory = std::make_shared<MemorySink>();
+    const auto json = std::make_shared<logger::JsonSink>( memory );
+    EXPECT_TRUE( sinks.add( json ) );
+
+    testing::internal::CaptureStdout();
+    {
+      const logger::Context flagScope( "cached", true );
+      const logger::Context otherFlagScope( "retried", false );
+      const logger::Context characterScope( "grade", 'A' );
+      const logger::Context byteScope( "byte", static_cast<unsigned char>( 65 ) );
+      logInfo() << "types";
+    }
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    sinks.remove( json );
+
+    ASSERT_EQ( output.size(), 1 );
+    EXPECT_TRUE( output[ 0 ].ends_with( " TestBody [cached=true retried=false grade=A byte=65] \"types\" " ) ) << output[ 0 ];
+
+    const std::vector records = memory->records();
+    ASSERT_EQ( records.size(), 1 );
+    EXPECT_TRUE( records[ 0 ].ends_with( ",\"cached\":true,\"retried\":false,\"grade\":\"A\",\"byte\":65}\n" ) ) << records[ 0 ];
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+namespace {
+
+  /**
+   * @brief Count the lines of a file.
+   * @param _filename   The filename.
+   * @return Number of lines.
+   */
+  std::size_t countLines( const std::string &_filename ) {
+
+    std::ifstream input( _filename );
+    std::string line {};
+    std::size_t result = 0;
+    while ( std::getline( input, line ) ) {
+
+      result++;
+    }
+    return result;
+  }
+}
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerFile, Write ) {
+
+    const std::string filename = "test_logger_file_write.log";
+    std::filesystem::remove( filename );
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    logger::Configuration::instance().setFilename( filename );
+
+    testing::internal::CaptureStdout();
+    for ( std::int32_t i = 0; i < 1000; i++ ) {
+
+      logInfo() << "record" << i;
+    }
+    logger::Configuration::instance().setFilename( "" );
+    EXPECT_TRUE( testing::internal::GetCapturedStdout().empty() );
+
+    EXPECT_EQ( countLines( filename ), 1000 );
+    std::filesystem::remove( filename );
+  }
+
+  TEST( LoggerFile, Rotate ) {
+
+    constexpr std::size_t maxFiles = 2;
+    const std::string filename = "test_logger_file_rotate.log";
+    for ( const std::string &name : { filename, filename + ".1", filename + ".2", filename + ".3" } ) {
+
+      std::filesystem::remove( name );
+    }
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    logger::Configuration::instance().setMaxFileSize( 1024 );
+    logger::Configuration::instance().setMaxFiles( maxFiles );
+    logger::Configuration::instance().setFilename( filename );
+
+    for ( std::int32_t i = 0; i < 100; i++ ) {
+
+      logInfo() << "record" << i;
+
+      /* Every record is a batch of its own. */
+      logFatal() << "fatal" << i;
+    }
+    logger::Configuration::instance().setFilename( "" );
+    logger::Configuration::instance().setMaxFileSize( 0 );
+
+    EXPECT_TRUE( std::filesystem::exists( filename + ".1" ) );
+    EXPECT_TRUE( std::filesystem::exists( filename + ".2" ) );
+    EXPECT_FALSE( std::filesystem::exists( filename + ".3" ) );
+    for ( const std::string &name : { filename, filename + ".1", filename + ".2" } ) {
+
+      EXPECT_LE( std::filesystem::file_size( name ), 1024 );
+      EXPECT_GT( countLines( name ), 0 );
+      std::filesystem::remove( name );
+    }
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* stl header */
+#include <algorithm>
+#include <cstddef> // std::size_t
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* modern.cpp.core */
+#include <Logger_sink.h>
+
+/**
+ * @brief vx (VX APPS) test helper namespace.
+ */
+namespace vx::test {
+
+  /**
+   * @brief Split the captured output into lines.
+   * @param _output   Captured output.
+   * @return Lines of the output.
+   */
+  inline std::vector<std::string> lines( const std::string &_output ) {
+
+    std::vector<std::string> result {};
+    std::istringstream stream( _output );
+    std::string line {};
+    while ( std::getline( stream, line ) ) {
+
+      result.emplace_back( line );
+    }
+    return result;
+  }
+
+  /**
+   * @brief Sink, that collects the records.
+   */
+  class MemorySink : public vx::logger::Sink {
+
+  public:
+    /**
+     * @brief Default constructor for MemorySink.
+     * @param _threshold   Records below this severity are not written to the sink.
+     */
+    explicit MemorySink( vx::logger::Severity _threshold = vx::logger::Severity::Verbose )
+      : Sink( _threshold ) {}
+
+    /**
+     * @copydoc Sink::write()
+     */
+    void write( const vx::logger::Entry &_entry ) noexcept override {
+
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      m_records.emplace_back( _entry.text );
+    }
+
+    /**
+     * @brief Get the collected records.
+     * @return Collected records.
+     */
+    std::vector<std::string> records() {
+
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      return m_records;
+    }
+
+    /**
+     * @brief Count the records containing a text.
+     * @param _text   Text to find.
+     * @return Number of records containing the text.
+     */
+    std::size_t count( const std::string &_text ) {
+
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      return static_cast<std::size_t>( std::count_if( m_records.begin(), m_records.end(), [ &_text ]( const std::string &_record ) { return _record.find( _text ) != std::string::npos; } ) );
+    }
+
+  private:
+    /**
+     * @brief Member for mutex.
+     */
+    std::mutex m_mutex {};
+
+    /**
+     * @brief Member for collected records.
+     */
+    std::vector<std::string> m_records {};
+  };
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger_category.h>
+#include <Logger_context.h>
+#include <Logger_json.h>
+
+/* local header */
+#include "test_logger_helper.h"
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+using vx::test::MemorySink;
+
+namespace {
+
+  /**
+   * @brief Escape a text as JSON string.
+   * @param _text   Text to escape.
+   * @return Quoted and escaped text.
+   */
+  std::string escaped( std::string_view _text ) {
+
+    std::string result {};
+    vx::logger::json::appendString( result, _text );
+    return result;
+  }
+}
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerJson, Escape ) {
+
+    using namespace std::literals;
+
+    EXPECT_EQ( escaped( "plain" ), "\"plain\"" );
+    EXPECT_EQ( escaped( "say \"hi\"\\" ), "\"say \\\"hi\\\"\\\\\"" );
+    EXPECT_EQ( escaped( "a\nb\tc\r" ), "\"a\\nb\\tc\\r\"" );
+    EXPECT_EQ( escaped( "\x01\x1f"sv ), "\"\\u0001\\u001f\"" );
+    EXPECT_EQ( escaped( "\0"sv ), "\"\\u0000\"" );
+    EXPECT_EQ( escaped( "\xc3\xa4" ), "\"\xc3\xa4\"" );
+
+    std::string number {};
+    logger::json::appendNumber( number, std::numeric_limits<double>::quiet_NaN() );
+    number += ' ';
+    logger::json::appendNumber( number, 0.1 );
+    number += ' ';
+    logger::json::appendNumber( number, -42 );
+    EXPECT_EQ( number, "null 0.1 -42" );
+  }
+
+  TEST( LoggerJson, Fields ) {
+
+    using logger::kv;
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    logger::SinkRegistry &sinks = logger::SinkRegistry::instance();
+    const auto memory = std::make_shared<MemorySink>();
+    const auto json = std::make_shared<logger::JsonSink>( memory );
+    EXPECT_TRUE( sinks.add( json ) );
+
+    testing::internal::CaptureStdout();
+    logInfo() << "login" << kv( "user", 42 ) << kv( "name", std::string( "bo\"b" ) ) << kv( "ratio", 0.5 ) << kv( "ok", true );
+    logWarning( "{} left", "bob" );
+    const std::string text = testing::internal::GetCapturedStdout();
+    sinks.remove( json );
+
+    EXPECT_NE( text.find( " \"login\" user=42 name=\"bo\\\"b\" ratio=0.5 ok=true \n" ), std::string::npos );
+
+    const std::vector records = memory->records();
+    ASSERT_EQ( records.size(), 2 );
+    EXPECT_TRUE( records[ 0 ].starts_with( "{\"time\":\"" ) );
+    EXPECT_NE( records[ 0 ].find( "\",\"severity\":\"info\",\"file\":\"test_logger_json.cpp\",\"line\":" ), std::string::npos );
+    EXPECT_NE( records[ 0 ].find( ",\"function\":\"TestBody\"" ), std::string::npos );
+    EXPECT_TRUE( records[ 0 ].ends_with( ",\"message\":\"\\\"login\\\" user=42 name=\\\"bo\\\\\\\"b\\\" ratio=0.5 ok=true\",\"user\":42,\"name\":\"bo\\\"b\",\"ratio\":0.5,\"ok\":true}\n" ) );
+    EXPECT_NE( records[ 1 ].find( "\"severity\":\"warning\"" ), std::string::npos );
+    EXPECT_TRUE( records[ 1 ].ends_with( ",\"message\":\"bob left\"}\n" ) );
+  }
+
+  TEST( LoggerJson, ReservedKeys ) {
+
+    using logger::kv;
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    logger::SinkRegistry &sinks = logger::SinkRegistry::instance();
+    const auto memory = std::make_shared<MemorySink>();
+    const auto json = std::make_shared<logger::JsonSink>( memory );
+    EXPECT_TRUE( sinks.add( json ) );
+
+    testing::internal::CaptureStdout();
+    {
+      const logger::Context context( "time", "yesterday" );
+      logInfo() << "collide" << kv( "message", std::string( "mine" ) ) << kv( "severity", 3 ) << kv( "user", 1 );
+    }
+    const std::string text = testing::internal::GetCapturedStdout();
+    sinks.remove( json );
+
+    /* The text is unchanged, the JSON members of the record are not shadowed. */
+    EXPECT_NE( text.find( "[time=yesterday] " ), std::string::npos );
+    EXPECT_NE( text.find( " \"collide\" message=\"mine\" severity=3 user=1 \n" ), std::string::npos );
+    const std::vector records = memory->records();
+    ASSERT_EQ( records.size(), 1 );
+    EXPECT_NE( records[ 0 ].find( ",\"severity\":\"info\"," ), std::string::npos );
+    EXPECT_TRUE( records[ 0 ].ends_with( ",\"message\":\"\\\"collide\\\" message=\\\"mine\\\" severity=3 user=1\",\"_time\":\"yesterday\",\"_message\":\"mine\",\"_severity\":3,\"user\":1}\n" ) ) << records[ 0 ];
+    for ( const std::string_view key : { "\"time\":", "\"severity\":", "\"message\":" } ) {
+
+      EXPECT_EQ( records[ 0 ].find( key ), records[ 0 ].rfind( key ) ) << key;
+    }
+  }
+
+  TEST( LoggerJson, Category ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    logger::SinkRegistry &sinks = logger::SinkRegistry::instance();
+    const auto memory = std::make_shared<MemorySink>();
+    const auto json = std::make_shared<logger::JsonSink>( memory );
+    EXPECT_TRUE( sinks.add( json ) );
+
+    testing::internal::CaptureStdout();
+    logInfoIn( "net.serial" ) << "opened";
+    logger::Configuration::instance().setAsync( true );
+    logWarningIn( "net.serial" ) << "closed";
+    logger::Configuration::instance().setAsync( false );
+    const std::string text = testing::internal::GetCapturedStdout();
+    sinks.remove( json );
+
+    /* The text keeps the category in its header, the JSON has it as own field. */
+    EXPECT_NE( text.find( " [net.serial] \"opened\" \n" ), std::string::npos );
+    const std::vector records = memory->records();
+    ASSERT_EQ( records.size(), 2 );
+    EXPECT_TRUE( records[ 0 ].ends_with( ",\"category\":\"net.serial\",\"message\":\"\\\"opened\\\"\"}\n" ) );
+    EXPECT_TRUE( records[ 1 ].ends_with( ",\"category\":\"net.serial\",\"message\":\"\\\"closed\\\"\"}\n" ) );
+  }
+
+  TEST( LoggerJson, Async ) {
+
+    using logger::kv;
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    logger::SinkRegistry &sinks = logger::SinkRegistry::instance();
+    const auto memory = std::make_shared<MemorySink>();
+    const auto json = std::make_shared<logger::JsonSink>( memory, logger::Severity::Info );
+    EXPECT_TRUE( sinks.add( json ) );
+
+    testing::internal::CaptureStdout();
+    logger::Configuration::instance().setAsync( true );
+    logDebug() << "below" << kv( "id", 1 );
+    logInfo() << "async" << kv( "id", 2 );
+    logger::Configuration::instance().setAsync( false );
+    testing::internal::GetCapturedStdout();
+    sinks.remove( json );
+
+    const std::vector records = memory->records();
+    ASSERT_EQ( records.size(), 1 );
+    EXPECT_TRUE( records[ 0 ].ends_with( ",\"message\":\"\\\"async\\\" id=2\",\"id\":2}\n" ) );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
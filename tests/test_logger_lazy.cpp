@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger.h>
+#include <Logger_container.h>
+#include <Logger_lazy.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerLazy, Severity ) {
+
+    using logger::lazy;
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Info );
+    std::int32_t evaluated = 0;
+    testing::internal::CaptureStdout();
+    logDebug() << lazy( [ &evaluated ] { return ++evaluated; } );
+    logInfo() << "lazy" << lazy( [ &evaluated ] { return ++evaluated; } );
+    const std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_EQ( evaluated, 1 );
+    EXPECT_NE( output.find( "\"lazy\" 1 " ), std::string::npos );
+  }
+
+  TEST( LoggerLazy, FlightRecorder ) {
+
+    using logger::lazy;
+
+    /* The record is captured by the flight recorder, but not written. */
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Info );
+    logger::Configuration::instance().setFlightRecorder( true );
+    std::int32_t evaluated = 0;
+    testing::internal::CaptureStdout();
+    logDebug() << "recorded" << lazy( [ &evaluated ] { return ++evaluated; } );
+    EXPECT_TRUE( testing::internal::GetCapturedStdout().empty() );
+    EXPECT_EQ( evaluated, 0 );
+    logger::Configuration::instance().setFlightRecorder( false );
+  }
+
+  TEST( LoggerLazy, Values ) {
+
+    using logger::lazy;
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    const std::map<std::string, std::int32_t> counters { { "a", 1 }, { "b", 2 } };
+    testing::internal::CaptureStdout();
+    logDebug() << lazy( [ &counters ] {
+
+      std::ostringstream summary {};
+      for ( const auto &[ key, value ] : counters ) {
+
+        summary << key << value;
+      }
+      return summary.str();
+    } ) << lazy( [] { return std::vector { 1, 2, 3 }; } );
+    const std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_NE( output.find( "\"a1b2\" std::vector<int> {1, 2, 3} " ), std::string::npos );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <algorithm> // std::count_if
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger_limit.h>
+
+/* local header */
+#include "test_logger_helper.h"
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+using vx::test::lines;
+
+namespace {
+
+  /**
+   * @brief Number of lines, that contain the text.
+   * @param _output   Lines of the output.
+   * @param _text   Text to find.
+   * @return Number of lines with the text.
+   */
+  std::ptrdiff_t count( const std::vector<std::string> &_output,
+                        const std::string &_text ) {
+
+    return std::count_if( _output.begin(), _output.end(), [ &_text ]( const std::string &_line ) { return _line.find( _text ) != std::string::npos; } );
+  }
+
+  /**
+   * @brief Summary of suppressed records.
+   * @param _count   Number of suppressed records.
+   * @return Text of the summary.
+   */
+  std::string summary( std::uint64_t _count ) {
+
+    return "\"records suppressed by rate limit\" " + std::to_string( _count );
+  }
+}
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerLimit, EveryN ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    std::int32_t evaluated = 0;
+    testing::internal::CaptureStdout();
+    for ( std::int32_t i = 0; i < 100; i++ ) {
+
+      logEveryN( logger::Severity::Info, 10 ) << ++evaluated;
+    }
+    std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 10 );
+    EXPECT_EQ( evaluated, 10 );
+    EXPECT_TRUE( output[ 1 ].ends_with( " 2 " ) );
+
+    /* The summary is a record of the call site. */
+    testing::internal::CaptureStdout();
+    logger::limit::Summary::instance().summarize();
+    output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( count( output, summary( 90 ) ), 1 );
+    EXPECT_EQ( count( output, "test_logger_limit.cpp" ), output.size() );
+
+    /* Nothing new to summarize. */
+    testing::internal::CaptureStdout();
+    logger::limit::Summary::instance().summarize();
+    EXPECT_TRUE( testing::internal::GetCapturedStdout().empty() );
+  }
+
+  TEST( LoggerLimit, FirstN ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    for ( std::int32_t i = 0; i < 100; i++ ) {
+
+      logFirstN( logger::Severity::Info, 3 ) << i;
+    }
+    std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 3 );
+    EXPECT_NE( output[ 2 ].find( " 2 " ), std::string::npos );
+
+    testing::internal::CaptureStdout();
+    logger::limit::Summary::instance().summarize();
+    output = lines( testing::internal::GetCapturedStdout() );
+    EXPECT_EQ( count( output, summary( 97 ) ), 1 );
+  }
+
+  TEST( LoggerLimit, Threads ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    /* Counters of exited threads are kept for the summary. */
+    testing::internal::CaptureStdout();
+    std::vector<std::thread> threads {};
+    for ( std::int32_t thread = 0; thread < 4; thread++ ) {
+
+      threads.emplace_back( [] {
+
+        for ( std::int32_t i = 0; i < 25; i++ ) {
+
+          logFirstN( logger::Severity::Warning, 1 ) << "threads" << i;
+        }
+      } );
+    }
+    for ( std::thread &thread : threads ) {
+
+      thread.join();
+    }
+    logger::limit::Summary::instance().summarize();
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    EXPECT_EQ( count( output, "\"threads\"" ), 1 );
+    EXPECT_EQ( count( output, summary( 99 ) ), 1 );
+  }
+
+  TEST( LoggerLimit, Format ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    for ( std::int32_t i = 0; i < 3; i++ ) {
+
+      logFirstN( logger::Severity::Info, 1, "{} of {}", i, 3 );
+    }
+
+    /* An expression, that fits into if/else without braces. */
+    if ( const bool limited = true; limited )
+      logEveryN( logger::Severity::Info, 2 ) << "branch";
+    else
+      logInfo() << "other";
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    ASSERT_EQ( output.size(), 2 );
+    EXPECT_TRUE( output[ 0 ].ends_with( " 0 of 3" ) );
+    EXPECT_TRUE( output[ 1 ].ends_with( " \"branch\" " ) );
+  }
+
+  TEST( LoggerLimit, Periodic ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    logger::limit::Summary &summaries = logger::limit::Summary::instance();
+    const std::chrono::milliseconds interval = summaries.interval();
+
+    /* A call site, that went quiet, is summarized without another record. */
+    testing::internal::CaptureStdout();
+    summaries.setInterval( std::chrono::milliseconds( 10 ) );
+    for ( std::int32_t i = 0; i < 5; i++ ) {
+
+      logFirstN( logger::Severity::Info, 1 ) << "periodic";
+    }
+    std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+    summaries.setInterval( interval );
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    EXPECT_EQ( count( output, summary( 4 ) ), 1 );
+  }
+
+  TEST( LoggerLimit, EveryMs ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    for ( std::int32_t i = 0; i < 100; i++ ) {
+
+      logEveryMs( logger::Severity::Info, 60000 ) << i;
+    }
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    EXPECT_EQ( output.size(), 1 );
+  }
+
+  TEST( LoggerLimit, TokenBucket ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    for ( std::int32_t i = 0; i < 100; i++ ) {
+
+      logRateLimited( logger::Severity::Info, 1, 5 ) << i;
+    }
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    EXPECT_EQ( output.size(), 5 );
+  }
+
+  TEST( LoggerLimit, ZeroRate ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    for ( std::int32_t i = 0; i < 10; i++ ) {
+
+      logRateLimited( logger::Severity::Info, 0, 1 ) << i;
+    }
+    logger::limit::Summary::instance().summarize();
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    EXPECT_EQ( count( output, summary( 10 ) ), 1 );
+    EXPECT_EQ( count( output, "INFO" ), count( output, "records suppressed by rate limit" ) );
+  }
+
+  TEST( LoggerLimit, Disabled ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Info );
+
+    testing::internal::CaptureStdout();
+    for ( std::int32_t i = 0; i < 10; i++ ) {
+
+      /* Disabled records do not count. */
+      logFirstN( logger::Severity::Debug, 1 ) << i;
+    }
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    const std::vector output = lines( testing::internal::GetCapturedStdout() );
+    EXPECT_TRUE( output.empty() );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
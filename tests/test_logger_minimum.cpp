@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Raised for this binary only, records below compile to nothing. */
+#undef CORE_LOG_MIN_SEVERITY
+#define CORE_LOG_MIN_SEVERITY Info
+
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <string>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger.h>
+#include <Logger_category.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+namespace {
+
+  /**
+   * @brief Number of evaluated arguments.
+   */
+  std::int32_t evaluated = 0;
+
+  /**
+   * @brief Argument, that counts its evaluation.
+   * @return Number of evaluated arguments.
+   */
+  std::int32_t evaluate() noexcept { return ++evaluated; }
+}
+
+/* The check of the macros is a constant, the configuration is never read. */
+static_assert( vx::logger::Severity::Debug < vx::logger::minimumSeverity, "Debug is removed at compile time" );
+static_assert( !( vx::logger::Severity::Info < vx::logger::minimumSeverity ), "Info is kept" );
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerMinimum, Removed ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+
+    testing::internal::CaptureStdout();
+    logVerbose() << evaluate();
+    logDebug() << evaluate();
+    logDebugIn( "net" ) << evaluate();
+    logInfo() << evaluate();
+    const std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_EQ( evaluated, 1 );
+    EXPECT_NE( output.find( "[INFO]" ), std::string::npos );
+    EXPECT_EQ( output.find( "[DEBUG]" ), std::string::npos );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* c header */
+#include <cstdint> // std::int32_t, std::uint64_t
+
+/* stl header */
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger.h>
+#include <Logger_async.h>
+#include <Logger_lazy.h>
+#include <Logger_sink.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+namespace {
+
+  /**
+   * @brief Sink, that stalls the background writer until it is opened and collects the records.
+   */
+  class GateSink : public vx::logger::Sink {
+
+  public:
+    /**
+     * @copydoc Sink::write()
+     */
+    void write( const vx::logger::Entry &_entry ) noexcept override {
+
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      m_records.emplace_back( _entry.text );
+    }
+
+    /**
+     * @copydoc Sink::append()
+     */
+    void append( const vx::logger::Entry &_entry ) noexcept override {
+
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_stalled = true;
+      m_condition.notify_all();
+      m_condition.wait( lock, [ this ] { return m_open; } );
+      m_records.emplace_back( _entry.text );
+    }
+
+    /**
+     * @brief Wait until the background writer is stalled.
+     */
+    void waitStalled() {
+
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_condition.wait( lock, [ this ] { return m_stalled; } );
+    }
+
+    /**
+     * @brief Let the background writer continue.
+     */
+    void open() {
+
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      m_open = true;
+      m_condition.notify_all();
+    }
+
+    /**
+     * @brief Get the collected records.
+     * @return Collected records.
+     */
+    std::vector<std::string> records() {
+
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      return m_records;
+    }
+
+  private:
+    /**
+     * @brief Member for mutex.
+     */
+    std::mutex m_mutex {};
+
+    /**
+     * @brief Condition member.
+     */
+    std::condition_variable m_condition {};
+
+    /**
+     * @brief Member for stalled state of the background writer.
+     */
+    bool m_stalled = false;
+
+    /**
+     * @brief Member for open state.
+     */
+    bool m_open = false;
+
+    /**
+     * @brief Member for collected records.
+     */
+    std::vector<std::string> m_records {};
+  };
+
+  /**
+   * @brief Records, that fit into the queue of the background writer plus the stalled one.
+   */
+  constexpr std::int32_t queued = 8192 + 1;
+
+  /**
+   * @brief Replace the console by the sink, stall the background writer with a first record.
+   * @param _sink   Sink to install.
+   * @param _overflow   Overflow policy.
+   */
+  void stall( const std::shared_ptr<GateSink> &_sink,
+              vx::logger::Overflow _overflow ) {
+
+    vx::logger::Configuration::instance().setAvoidLogBelow( vx::logger::Severity::Verbose );
+    vx::logger::Configuration::instance().setOverflow( _overflow );
+    vx::logger::SinkRegistry &sinks = vx::logger::SinkRegistry::instance();
+    sinks.add( _sink );
+    sinks.remove( sinks.console() );
+    vx::logger::Configuration::instance().setAsync( true );
+    logInfo() << "stalled";
+    _sink->waitStalled();
+  }
+
+  /**
+   * @brief Open the sink, wait for the background writer and restore the console.
+   * @param _sink   Sink to remove.
+   */
+  void release( const std::shared_ptr<GateSink> &_sink ) {
+
+    _sink->open();
+    vx::logger::Configuration::instance().setAsync( false );
+    vx::logger::Configuration::instance().setOverflow( vx::logger::Overflow::Block );
+    vx::logger::SinkRegistry &sinks = vx::logger::SinkRegistry::instance();
+    sinks.add( sinks.console() );
+    sinks.remove( _sink );
+  }
+
+  /**
+   * @brief Count the records containing a text.
+   * @param _records   Records to search.
+   * @param _text   Text to find.
+   * @return Number of records containing the text.
+   */
+  std::size_t count( const std::vector<std::string> &_records,
+                     const std::string &_text ) {
+
+    return static_cast<std::size_t>( std::count_if( _records.begin(), _records.end(), [ &_text ]( const std::string &_record ) { return _record.find( _text ) != std::string::npos; } ) );
+  }
+}
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerOverflow, DropNewest ) {
+
+    constexpr std::int32_t total = queued + 100;
+    const auto sink = std::make_shared<GateSink>();
+    const std::uint64_t before = logger::AsyncWriter::instance().dropped( logger::Severity::Debug );
+    stall( sink, logger::Overflow::DropNewest );
+    for ( std::int32_t i = 0; i < total; i++ ) {
+
+      logDebug() << "newest" << i;
+    }
+    EXPECT_EQ( logger::AsyncWriter::instance().dropped( logger::Severity::Debug ) - before, 101 );
+    release( sink );
+
+    const std::vector records = sink->records();
+    EXPECT_EQ( count( records, "\"newest\"" ), queued - 1 );
+    EXPECT_EQ( count( records, "\"newest\" 0 " ), 1 );
+    EXPECT_EQ( count( records, "\"newest\" " + std::to_string( queued - 1 ) + ' ' ), 0 );
+  }
+
+  TEST( LoggerOverflow, DropOldest ) {
+
+    constexpr std::int32_t total = queued + 100;
+    const auto sink = std::make_shared<GateSink>();
+    const std::uint64_t before = logger::AsyncWriter::instance().dropped( logger::Severity::Debug );
+    stall( sink, logger::Overflow::DropOldest );
+    for ( std::int32_t i = 0; i < total; i++ ) {
+
+      logDebug() << "oldest" << i;
+    }
+    EXPECT_EQ( logger::AsyncWriter::instance().dropped( logger::Severity::Debug ) - before, 101 );
+    release( sink );
+
+    const std::vector records = sink->records();
+    EXPECT_EQ( count( records, "\"oldest\"" ), queued - 1 );
+    EXPECT_EQ( count( records, "\"oldest\" 100 " ), 0 );
+    EXPECT_EQ( count( records, "\"oldest\" 101 " ), 1 );
+    EXPECT_EQ( count( records, "\"oldest\" " + std::to_string( total - 1 ) + ' ' ), 1 );
+  }
+
+  TEST( LoggerOverflow, DropBySeverity ) {
+
+    const auto sink = std::make_shared<GateSink>();
+    const std::uint64_t before = logger::AsyncWriter::instance().dropped( logger::Severity::Info );
+    const std::uint64_t errorsBefore = logger::AsyncWriter::instance().dropped( logger::Severity::Error );
+    stall( sink, logger::Overflow::DropBySeverity );
+    for ( std::int32_t i = 0; i < queued; i++ ) {
+
+      logInfo() << "severity" << i;
+    }
+
+    /* The error waits for room instead of being dropped. */
+    std::thread error( [] { logError() << "kept"; } );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    sink->open();
+    error.join();
+    EXPECT_EQ( logger::AsyncWriter::instance().dropped( logger::Severity::Info ) - before, 1 );
+    EXPECT_EQ( logger::AsyncWriter::instance().dropped( logger::Severity::Error ) - errorsBefore, 0 );
+    release( sink );
+    EXPECT_EQ( count( sink->records(), "\"kept\"" ), 1 );
+  }
+
+  TEST( LoggerOverflow, Lazy ) {
+
+    using logger::lazy;
+
+    const auto sink = std::make_shared<GateSink>();
+    stall( sink, logger::Overflow::DropNewest );
+    std::int32_t evaluated = 0;
+    for ( std::int32_t i = 0; i < queued; i++ ) {
+
+      logDebug() << lazy( [ &evaluated ] { return ++evaluated; } );
+    }
+
+    /* The last record would be dropped, so it is not evaluated at all. */
+    EXPECT_EQ( evaluated, queued - 1 );
+    release( sink );
+  }
+
+  TEST( LoggerOverflow, Summary ) {
+
+    const auto sink = std::make_shared<GateSink>();
+    stall( sink, logger::Overflow::DropNewest );
+    for ( std::int32_t i = 0; i < queued + 1; i++ ) {
+
+      logVerbose() << "summary" << i;
+    }
+    logWarning() << "dropped";
+    sink->open();
+
+    /* The summary follows the next batch, at most once per interval. */
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 5 );
+    while ( count( sink->records(), "records dropped" ) == 0 && std::chrono::steady_clock::now() < deadline ) {
+
+      logInfo() << "tick";
+      std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    }
+    release( sink );
+
+    const std::vector records = sink->records();
+    ASSERT_EQ( count( records, "records dropped" ), 1 );
+    const auto summary = std::find_if( records.begin(), records.end(), []( const std::string &_record ) { return _record.find( "records dropped" ) != std::string::npos; } );
+    EXPECT_NE( summary->find( "[WARNING]" ), std::string::npos );
+    EXPECT_NE( summary->find( "\"records dropped by overflow policy\"" ), std::string::npos );
+
+    /* Drops of the previous tests may be summarized together with these. */
+    EXPECT_NE( summary->find( "verbose=2 " ), std::string::npos );
+    EXPECT_NE( summary->find( "warning=1 " ), std::string::npos );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* system header */
+#ifndef _WIN32
+  #include <signal.h>
+#endif
+
+/* c header */
+#include <csignal>
+#include <cstdint> // std::int32_t
+#include <cstdio> // std::tmpfile
+#include <cstdlib> // std::abort
+
+/* stl header */
+#include <string>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger.h>
+#include <Logger_recorder.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+namespace {
+
+  /**
+   * @brief Signals seen by the handler, that was installed before the recorder.
+   */
+  volatile std::sig_atomic_t previousCalls = 0;
+
+  /**
+   * @brief Handler, that was installed before the recorder.
+   */
+  extern "C" void previousHandler( std::int32_t ) { previousCalls = previousCalls + 1; }
+
+  /**
+   * @brief Dump the flight recorder into a string.
+   * @return Dumped records.
+   */
+  std::string dump() {
+
+    std::FILE *file = std::tmpfile();
+#ifdef _WIN32
+    vx::logger::FlightRecorder::instance().dump( _fileno( file ) );
+#else
+    vx::logger::FlightRecorder::instance().dump( fileno( file ) );
+#endif
+    std::rewind( file );
+    std::string result {};
+    for ( std::int32_t character = std::fgetc( file ); character != EOF; character = std::fgetc( file ) ) {
+
+      result += static_cast<char>( character );
+    }
+    std::fclose( file );
+    return result;
+  }
+}
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerRecorder, Filtered ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Warning );
+    logger::Configuration::instance().setFlightRecorder( true );
+
+    testing::internal::CaptureStdout();
+    logDebug() << "filtered debug";
+    logVerbose() << "filtered verbose";
+    EXPECT_TRUE( testing::internal::GetCapturedStdout().empty() );
+
+    const std::string output = dump();
+    EXPECT_NE( output.find( "\"filtered debug\"" ), std::string::npos );
+    EXPECT_NE( output.find( "\"filtered verbose\"" ), std::string::npos );
+  }
+
+  TEST( LoggerRecorder, Ring ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Warning );
+    logger::Configuration::instance().setFlightRecorder( true );
+
+    for ( std::size_t i = 0; i < logger::FlightRecorder::capacity + 10; i++ ) {
+
+      logDebug() << "ring" << i;
+    }
+    const std::string output = dump();
+    EXPECT_EQ( output.find( "\"ring\" 9 " ), std::string::npos );
+    EXPECT_NE( output.find( "\"ring\" 10 " ), std::string::npos );
+    EXPECT_NE( output.find( "\"ring\" " + std::to_string( logger::FlightRecorder::capacity + 9 ) + ' ' ), std::string::npos );
+  }
+
+  TEST( LoggerRecorder, Fatal ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Warning );
+    logger::Configuration::instance().setFlightRecorder( true );
+
+    testing::internal::CaptureStderr();
+    logDebug() << "before fatal";
+    logFatal() << "fatal";
+    const std::string output = testing::internal::GetCapturedStderr();
+    EXPECT_NE( output.find( "flight recorder" ), std::string::npos );
+    EXPECT_NE( output.find( "\"before fatal\"" ), std::string::npos );
+  }
+
+#ifndef _WIN32
+  TEST( LoggerRecorder, Chain ) {
+
+    logger::Configuration::instance().setFlightRecorder( false );
+    struct sigaction previous {};
+    previous.sa_handler = previousHandler;
+    sigemptyset( &previous.sa_mask );
+    struct sigaction saved {};
+    ASSERT_EQ( ::sigaction( SIGABRT, &previous, &saved ), 0 );
+
+    /* The recorder is dumped, then the previous handler runs. */
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Warning );
+    logger::Configuration::instance().setFlightRecorder( true );
+    logDebug() << "chained";
+    testing::internal::CaptureStderr();
+    std::raise( SIGABRT );
+    EXPECT_NE( testing::internal::GetCapturedStderr().find( "\"chained\"" ), std::string::npos );
+    EXPECT_EQ( previousCalls, 1 );
+
+    /* Disabling the recorder restores the previous handler. */
+    logger::Configuration::instance().setFlightRecorder( false );
+    logger::Configuration::instance().setFlightRecorder( true );
+    struct sigaction current {};
+    ::sigaction( SIGABRT, nullptr, &current );
+    EXPECT_NE( current.sa_handler, previousHandler );
+    logger::Configuration::instance().setFlightRecorder( false );
+    ::sigaction( SIGABRT, nullptr, &current );
+    EXPECT_EQ( current.sa_handler, previousHandler );
+
+    ::sigaction( SIGABRT, &saved, nullptr );
+  }
+#endif
+
+  TEST( LoggerRecorderDeathTest, Abort ) {
+
+    const auto crash = [] {
+
+      logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Warning );
+      logger::Configuration::instance().setFlightRecorder( true );
+      logDebug() << "context";
+      std::abort();
+    };
+    EXPECT_DEATH( crash(), "context" );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger.h>
+#include <Logger_category.h>
+#include <Logger_json.h>
+#include <Logger_lazy.h>
+#include <Logger_sink.h>
+
+/* local header */
+#include "test_logger_helper.h"
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+using vx::test::MemorySink;
+
+namespace {
+
+  /**
+   * @brief Records per test.
+   */
+  constexpr std::int32_t records = 10000;
+
+  /**
+   * @brief Replace the console by a memory sink.
+   * @param _sink   Sink to install.
+   */
+  void install( const std::shared_ptr<vx::logger::Sink> &_sink ) {
+
+    vx::logger::Configuration::instance().setAvoidLogBelow( vx::logger::Severity::Verbose );
+    vx::logger::SinkRegistry &sinks = vx::logger::SinkRegistry::instance();
+    sinks.add( _sink );
+    sinks.remove( sinks.console() );
+  }
+
+  /**
+   * @brief Restore the console.
+   * @param _sink   Sink to remove.
+   */
+  void uninstall( const std::shared_ptr<vx::logger::Sink> &_sink ) {
+
+    vx::logger::SinkRegistry &sinks = vx::logger::SinkRegistry::instance();
+    sinks.add( sinks.console() );
+    sinks.remove( _sink );
+  }
+}
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerSampling, Severity ) {
+
+    using logger::lazy;
+
+    const auto sink = std::make_shared<MemorySink>();
+    install( sink );
+    logger::Configuration::instance().setSampling( logger::Severity::Debug, 10 );
+
+    /* Sampled before anything is formatted, so lazy arguments of dropped records are not evaluated. */
+    std::int32_t evaluated = 0;
+    for ( std::int32_t i = 0; i < records; i++ ) {
+
+      logDebug() << "debug" << lazy( [ &evaluated ] { return ++evaluated; } );
+      logInfo() << "info";
+    }
+    logger::Configuration::instance().setSampling( logger::Severity::Debug, 1 );
+    uninstall( sink );
+
+    const std::size_t debug = sink->count( "\"debug\"" );
+    EXPECT_GT( debug, records / 10 / 2 );
+    EXPECT_LT( debug, records / 10 * 2 );
+    EXPECT_EQ( debug, static_cast<std::size_t>( evaluated ) );
+    EXPECT_EQ( sink->count( "[sampled 1/10] \"debug\"" ), debug );
+    EXPECT_EQ( sink->count( "\"info\"" ), records );
+    EXPECT_EQ( sink->count( "[sampled" ), debug );
+  }
+
+  TEST( LoggerSampling, Error ) {
+
+    const auto sink = std::make_shared<MemorySink>();
+    install( sink );
+    logger::Configuration::instance().setSampling( logger::Severity::Error, 1000 );
+    testing::internal::CaptureStderr();
+    for ( std::int32_t i = 0; i < 100; i++ ) {
+
+      logError() << "error";
+    }
+    testing::internal::GetCapturedStderr();
+    logger::Configuration::instance().setSampling( logger::Severity::Error, 1 );
+    uninstall( sink );
+
+    EXPECT_EQ( sink->count( "\"error\"" ), 100 );
+    EXPECT_EQ( sink->count( "[sampled" ), 0 );
+  }
+
+  TEST( LoggerSampling, Category ) {
+
+    const auto sink = std::make_shared<MemorySink>();
+    install( sink );
+    logger::Categories::instance().setSampling( "sampled", 100 );
+    logger::Categories::instance().setSampling( "sampled.all", 1 );
+    for ( std::int32_t i = 0; i < records; i++ ) {
+
+      logDebugIn( "sampled.child" ) << "child";
+      logDebugIn( "sampled.all" ) << "all";
+      logDebug() << "global";
+    }
+    logger::Categories::instance().resetSampling( "sampled" );
+    logger::Categories::instance().resetSampling( "sampled.all" );
+    uninstall( sink );
+
+    const std::size_t child = sink->count( "\"child\"" );
+    EXPECT_GT( child, records / 100 / 2 );
+    EXPECT_LT( child, records / 100 * 2 );
+    EXPECT_EQ( sink->count( "[sampled 1/100]" ), child );
+    EXPECT_EQ( sink->count( "\"all\"" ), records );
+    EXPECT_EQ( sink->count( "\"global\"" ), records );
+  }
+
+  TEST( LoggerSampling, Json ) {
+
+    const auto memory = std::make_shared<MemorySink>();
+    const auto json = std::make_shared<logger::JsonSink>( memory );
+    install( json );
+    logger::Configuration::instance().setSampling( logger::Severity::Verbose, 2 );
+    for ( std::int32_t i = 0; i < 100; i++ ) {
+
+      logVerbose() << "json";
+    }
+    logger::Configuration::instance().setSampling( logger::Severity::Verbose, 1 );
+    uninstall( json );
+
+    /* The mark is not part of the message, but a field. */
+    const std::size_t sampled = memory->count( ",\"message\":\"\\\"json\\\"\",\"sampleRate\":2}" );
+    EXPECT_GT( sampled, 0 );
+    EXPECT_EQ( memory->count( "\\\"json\\\"" ), sampled );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
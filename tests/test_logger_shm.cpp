@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* system header */
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* c header */
+#include <cstdint> // std::int32_t
+#include <cstdlib> // std::_Exit
+
+/* stl header */
+#include <string>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger_shm.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+namespace {
+
+  /**
+   * @brief Name of the shared memory for this test process.
+   * @param _suffix   Suffix of the name.
+   * @return Name of the shared memory.
+   */
+  std::string ringName( const std::string &_suffix ) {
+
+    return "/vx.logger.test." + std::to_string( ::getpid() ) + '.' + _suffix;
+  }
+}
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerShm, Process ) {
+
+    const std::string name = ringName( "process" );
+    logger::SharedRing reader {};
+    ASSERT_TRUE( reader.open( name ) );
+
+    /* The writer is another process, that exits without waiting for the reader. */
+    if ( const pid_t pid = ::fork(); pid == 0 ) {
+
+      logger::SharedSink sink {};
+      if ( !sink.open( name ) ) {
+
+        std::_Exit( EXIT_FAILURE );
+      }
+      for ( std::int32_t i = 0; i < 100; i++ ) {
+
+        const std::string text = "record " + std::to_string( i ) + '\n';
+        sink.write( logger::Entry { logger::Severity::Info, {}, {}, 0, {}, text, 0, {} } );
+      }
+      std::_Exit( EXIT_SUCCESS );
+    }
+    else {
+
+      ASSERT_GT( pid, 0 );
+      std::int32_t status = 0;
+      ::waitpid( pid, &status, 0 );
+      ASSERT_TRUE( WIFEXITED( status ) );
+      ASSERT_EQ( WEXITSTATUS( status ), EXIT_SUCCESS );
+    }
+
+    logger::Severity severity = logger::Severity::Verbose;
+    std::string text {};
+    for ( std::int32_t i = 0; i < 100; i++ ) {
+
+      ASSERT_TRUE( reader.pop( severity, text ) );
+      EXPECT_EQ( severity, logger::Severity::Info );
+      EXPECT_EQ( text, "record " + std::to_string( i ) + '\n' );
+    }
+    EXPECT_FALSE( reader.pop( severity, text ) );
+    EXPECT_EQ( reader.lost(), 0 );
+    EXPECT_EQ( reader.dropped(), 0 );
+    logger::SharedRing::remove( name );
+  }
+
+  TEST( LoggerShm, Restart ) {
+
+    const std::string name = ringName( "restart" );
+    logger::SharedRing writer {};
+    ASSERT_TRUE( writer.open( name ) );
+    for ( std::int32_t i = 0; i < 6; i++ ) {
+
+      EXPECT_TRUE( writer.push( logger::Severity::Warning, std::to_string( i ) ) );
+    }
+
+    logger::Severity severity = logger::Severity::Verbose;
+    std::string text {};
+    {
+      logger::SharedRing reader {};
+      ASSERT_TRUE( reader.open( name ) );
+      for ( std::int32_t i = 0; i < 3; i++ ) {
+
+        ASSERT_TRUE( reader.pop( severity, text ) );
+        EXPECT_EQ( text, std::to_string( i ) );
+      }
+    }
+
+    /* The writer continues without reader, the restarted reader continues where the last one stopped. */
+    EXPECT_TRUE( writer.push( logger::Severity::Warning, "6" ) );
+    logger::SharedRing reader {};
+    ASSERT_TRUE( reader.open( name ) );
+    for ( std::int32_t i = 3; i < 7; i++ ) {
+
+      ASSERT_TRUE( reader.pop( severity, text ) );
+      EXPECT_EQ( text, std::to_string( i ) );
+    }
+    EXPECT_FALSE( reader.pop( severity, text ) );
+    logger::SharedRing::remove( name );
+  }
+
+  TEST( LoggerShm, Overrun ) {
+
+    const std::string name = ringName( "overrun" );
+    logger::SharedRing writer {};
+    ASSERT_TRUE( writer.open( name ) );
+    for ( std::size_t i = 0; i < logger::SharedRing::capacity + 10; i++ ) {
+
+      EXPECT_TRUE( writer.push( logger::Severity::Debug, std::to_string( i ) ) );
+    }
+    EXPECT_TRUE( writer.push( logger::Severity::Debug, std::string( logger::SharedRing::textSize + 10, 'x' ) + '\n' ) );
+
+    logger::SharedRing reader {};
+    ASSERT_TRUE( reader.open( name ) );
+    logger::Severity severity = logger::Severity::Verbose;
+    std::string text {};
+    ASSERT_TRUE( reader.pop( severity, text ) );
+    EXPECT_EQ( text, "11" );
+    EXPECT_EQ( reader.lost(), 11 );
+
+    std::size_t count = 1;
+    while ( reader.pop( severity, text ) ) {
+
+      count++;
+    }
+    EXPECT_EQ( count, logger::SharedRing::capacity );
+    EXPECT_EQ( text.size(), logger::SharedRing::textSize );
+    EXPECT_EQ( text.back(), '\n' );
+    logger::SharedRing::remove( name );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
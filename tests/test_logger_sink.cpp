@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger_sink.h>
+
+/* local header */
+#include "test_logger_helper.h"
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+using vx::test::MemorySink;
+
+namespace {
+
+  /**
+   * @brief Sink, that counts records written after it was closed.
+   */
+  class ClosingSink : public vx::logger::Sink {
+
+  public:
+    /**
+     * @copydoc Sink::write()
+     */
+    void write( [[maybe_unused]] const vx::logger::Entry &_entry ) noexcept override {
+
+      /* Widen the window between loading the sink and writing to it. */
+      std::this_thread::yield();
+      if ( m_closed.load( std::memory_order_relaxed ) ) {
+
+        m_late.fetch_add( 1, std::memory_order_relaxed );
+      }
+    }
+
+    /**
+     * @copydoc Sink::close()
+     */
+    void close() noexcept override { m_closed.store( true, std::memory_order_relaxed ); }
+
+    /**
+     * @brief Get the number of records written after close().
+     * @return Number of late records.
+     */
+    [[nodiscard]] std::size_t late() const noexcept { return m_late.load( std::memory_order_relaxed ); }
+
+  private:
+    /**
+     * @brief Member for closed state.
+     */
+    std::atomic<bool> m_closed { false };
+
+    /**
+     * @brief Member for number of records written after close().
+     */
+    std::atomic<std::size_t> m_late { 0 };
+  };
+}
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerSink, Threshold ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    logger::SinkRegistry &sinks = logger::SinkRegistry::instance();
+    const auto info = std::make_shared<MemorySink>( logger::Severity::Info );
+    const auto error = std::make_shared<MemorySink>( logger::Severity::Error );
+    EXPECT_TRUE( sinks.add( info ) );
+    EXPECT_TRUE( sinks.add( error ) );
+    sinks.console()->setThreshold( logger::Severity::Fatal );
+
+    testing::internal::CaptureStdout();
+    logDebug() << "debug";
+    logInfo() << "info";
+    logError() << "error";
+    EXPECT_TRUE( testing::internal::GetCapturedStdout().empty() );
+
+    sinks.remove( info );
+    sinks.remove( error );
+    sinks.console()->setThreshold( logger::Severity::Verbose );
+    logInfo() << "removed";
+
+    const std::vector infoRecords = info->records();
+    ASSERT_EQ( infoRecords.size(), 2 );
+    EXPECT_NE( infoRecords[ 0 ].find( "\"info\"" ), std::string::npos );
+    EXPECT_NE( infoRecords[ 1 ].find( "\"error\"" ), std::string::npos );
+
+    const std::vector errorRecords = error->records();
+    ASSERT_EQ( errorRecords.size(), 1 );
+    EXPECT_EQ( errorRecords[ 0 ], infoRecords[ 1 ] );
+  }
+
+  TEST( LoggerSink, Async ) {
+
+    constexpr std::int32_t count = 1000;
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    logger::SinkRegistry &sinks = logger::SinkRegistry::instance();
+    const auto sink = std::make_shared<MemorySink>( logger::Severity::Verbose );
+    EXPECT_TRUE( sinks.add( sink ) );
+    sinks.remove( sinks.console() );
+
+    logger::Configuration::instance().setAsync( true );
+    for ( std::int32_t i = 0; i < count; i++ ) {
+
+      logInfo() << i;
+    }
+    logger::Configuration::instance().setAsync( false );
+
+    sinks.add( sinks.console() );
+    sinks.remove( sink );
+    EXPECT_EQ( sink->records().size(), count );
+  }
+
+  TEST( LoggerSink, FatalFlush ) {
+
+    logger::Configuration &configuration = logger::Configuration::instance();
+    configuration.setAvoidLogBelow( logger::Severity::Verbose );
+    logger::SinkRegistry &sinks = logger::SinkRegistry::instance();
+    const auto sink = std::make_shared<MemorySink>( logger::Severity::Fatal );
+    EXPECT_TRUE( sinks.add( sink ) );
+    sinks.console()->setThreshold( logger::Severity::Fatal );
+
+    /* Other threads push concurrently, the fatal record is written before logFatal() returns anyway. */
+    configuration.setAsync( true );
+    std::atomic<bool> running { true };
+    std::vector<std::thread> threads {};
+    for ( std::int32_t i = 0; i < 4; i++ ) {
+
+      threads.emplace_back( [ &running ] {
+        while ( running ) {
+
+          logInfo() << "record";
+        }
+      } );
+    }
+    std::size_t missing = 0;
+    testing::internal::CaptureStderr();
+    for ( std::size_t i = 0; i < 200; i++ ) {
+
+      logFatal() << "fatal" << i;
+      missing += sink->records().size() <= i ? 1 : 0;
+    }
+    testing::internal::GetCapturedStderr();
+    running = false;
+    for ( std::thread &thread : threads ) {
+
+      thread.join();
+    }
+    EXPECT_EQ( missing, 0 );
+    configuration.setAsync( false );
+    sinks.remove( sink );
+    sinks.console()->setThreshold( logger::Severity::Verbose );
+  }
+
+  TEST( LoggerSink, Remove ) {
+
+    logger::Configuration &configuration = logger::Configuration::instance();
+    configuration.setAvoidLogBelow( logger::Severity::Verbose );
+    logger::SinkRegistry &sinks = logger::SinkRegistry::instance();
+    sinks.console()->setThreshold( logger::Severity::Fatal );
+
+    for ( const bool async : { false, true } ) {
+
+      configuration.setAsync( async );
+      std::atomic<bool> running { true };
+      std::vector<std::thread> threads {};
+      for ( std::int32_t i = 0; i < 4; i++ ) {
+
+        threads.emplace_back( [ &running ] {
+          while ( running ) {
+
+            logInfo() << "record";
+          }
+        } );
+      }
+      for ( std::int32_t i = 0; i < 100; i++ ) {
+
+        auto sink = std::make_shared<ClosingSink>();
+        EXPECT_TRUE( sinks.add( sink ) );
+        std::this_thread::yield();
+        sinks.remove( sink );
+
+        /* Closed after the last record and not kept alive by the registry. */
+        EXPECT_EQ( sink->late(), 0 );
+        EXPECT_EQ( sink.use_count(), 1 );
+      }
+      running = false;
+      for ( std::thread &thread : threads ) {
+
+        thread.join();
+      }
+      configuration.setAsync( false );
+    }
+    sinks.console()->setThreshold( logger::Severity::Verbose );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
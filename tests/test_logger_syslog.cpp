@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* system header */
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* c header */
+#include <cstdint> // std::int32_t
+#include <cstring> // std::memcpy
+
+/* stl header */
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Logger_syslog.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+namespace {
+
+  /**
+   * @brief Stand-in for the socket of the syslog daemon.
+   */
+  class Receiver {
+
+  public:
+    /**
+     * @brief Bind a datagram socket for this test process.
+     * @param _suffix   Suffix of the path.
+     */
+    explicit Receiver( const std::string &_suffix )
+      : m_path( "/tmp/vx.syslog.test." + std::to_string( ::getpid() ) + '.' + _suffix ) {
+
+      ::unlink( m_path.c_str() );
+      m_socket = ::socket( AF_UNIX, SOCK_DGRAM, 0 );
+      sockaddr_un address {};
+      address.sun_family = AF_UNIX;
+      std::memcpy( address.sun_path, m_path.data(), m_path.size() );
+      ::bind( m_socket, reinterpret_cast<const sockaddr *>( &address ), sizeof( address ) );
+    }
+
+    /**
+     * @brief Close the socket and remove its path.
+     */
+    ~Receiver() noexcept {
+
+      ::close( m_socket );
+      ::unlink( m_path.c_str() );
+    }
+
+    Receiver( const Receiver & ) = delete;
+    Receiver( Receiver && ) = delete;
+    Receiver &operator=( const Receiver & ) = delete;
+    Receiver &operator=( Receiver && ) = delete;
+
+    /**
+     * @brief Path of the socket.
+     * @return Path of the socket.
+     */
+    [[nodiscard]] const std::string &path() const noexcept { return m_path; }
+
+    /**
+     * @brief Receive all pending datagrams.
+     * @return Datagrams in order of arrival.
+     */
+    [[nodiscard]] std::vector<std::string> receive() const {
+
+      std::vector<std::string> datagrams {};
+      std::array<char, vx::logger::SyslogSink::datagramSize + 1> buffer {};
+      while ( true ) {
+
+        const ssize_t size = ::recv( m_socket, buffer.data(), buffer.size(), MSG_DONTWAIT );
+        if ( size < 0 ) {
+
+          break;
+        }
+        datagrams.emplace_back( buffer.data(), static_cast<std::size_t>( size ) );
+      }
+      return datagrams;
+    }
+
+  private:
+    std::string m_path {};
+    std::int32_t m_socket = -1;
+  };
+}
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( LoggerSyslog, Format ) {
+
+    const Receiver receiver( "format" );
+    logger::SyslogSink sink( "test app" );
+    ASSERT_TRUE( sink.open( receiver.path() ) );
+    EXPECT_TRUE( sink.isOpen() );
+
+    const std::string text = "header message \n";
+    sink.write( logger::Entry { logger::Severity::Info, {}, "main.cpp", 42, "main", text, 7, {} } );
+    sink.write( logger::Entry { logger::Severity::Fatal, {}, "a\"b].cpp", 1, "f\\", text, 7, {} } );
+    sink.write( logger::Entry { logger::Severity::Debug, {}, {}, 0, {}, text, text.size(), {} } );
+    sink.write( logger::Entry { logger::Severity::Info, {}, "main.cpp", 7, "main", text, 7, {}, "net.serial" } );
+
+    const std::vector datagrams = receiver.receive();
+    ASSERT_EQ( datagrams.size(), 4 );
+    EXPECT_TRUE( datagrams[ 0 ].starts_with( "<14>1 " ) );
+    EXPECT_NE( datagrams[ 0 ].find( " test_app " + std::to_string( ::getpid() ) + " - " ), std::string::npos );
+    EXPECT_TRUE( datagrams[ 0 ].ends_with( " - [vx@32473 file=\"main.cpp\" line=\"42\" function=\"main\"] message" ) );
+    EXPECT_TRUE( datagrams[ 1 ].starts_with( "<10>1 " ) );
+    EXPECT_TRUE( datagrams[ 1 ].ends_with( "[vx@32473 file=\"a\\\"b\\].cpp\" line=\"1\" function=\"f\\\\\"] message" ) );
+    EXPECT_TRUE( datagrams[ 2 ].starts_with( "<15>1 " ) );
+    EXPECT_TRUE( datagrams[ 2 ].ends_with( " - -" ) );
+    EXPECT_TRUE( datagrams[ 3 ].ends_with( "[vx@32473 file=\"main.cpp\" line=\"7\" function=\"main\" category=\"net.serial\"] message" ) );
+    EXPECT_EQ( sink.dropped(), 0 );
+  }
+
+  TEST( LoggerSyslog, Facility ) {
+
+    const Receiver receiver( "facility" );
+    logger::SyslogSink sink( "test", logger::Facility::Local0 );
+    ASSERT_TRUE( sink.open( receiver.path() ) );
+    sink.write( logger::Entry { logger::Severity::Error, {}, {}, 0, {}, "failed", 0, {} } );
+
+    const std::vector datagrams = receiver.receive();
+    ASSERT_EQ( datagrams.size(), 1 );
+    EXPECT_TRUE( datagrams[ 0 ].starts_with( "<131>1 " ) );
+    EXPECT_TRUE( datagrams[ 0 ].ends_with( " - - failed" ) );
+  }
+
+  TEST( LoggerSyslog, Async ) {
+
+    logger::Configuration::instance().setAvoidLogBelow( logger::Severity::Verbose );
+    const Receiver receiver( "async" );
+    const auto sink = std::make_shared<logger::SyslogSink>( "test" );
+    ASSERT_TRUE( sink->open( receiver.path() ) );
+    logger::SinkRegistry &sinks = logger::SinkRegistry::instance();
+    EXPECT_TRUE( sinks.add( sink ) );
+
+    /* Linux queues at least 10 datagrams per socket (net.unix.max_dgram_qlen), one batch fits without a reader. */
+    constexpr std::int32_t records = 10;
+    testing::internal::CaptureStdout();
+    logger::Configuration::instance().setAsync( true );
+    for ( std::int32_t i = 0; i < records; i++ ) {
+
+      logInfo() << "record" << i;
+    }
+    logger::Configuration::instance().setAsync( false );
+    testing::internal::GetCapturedStdout();
+    sinks.remove( sink );
+
+    const std::vector datagrams = receiver.receive();
+    ASSERT_EQ( datagrams.size(), records );
+    for ( std::int32_t i = 0; i < records; i++ ) {
+
+      EXPECT_TRUE( datagrams[ static_cast<std::size_t>( i ) ].ends_with( "] \"record\" " + std::to_string( i ) ) );
+    }
+    EXPECT_EQ( sink->dropped(), 0 );
+  }
+
+  TEST( LoggerSyslog, Drops ) {
+
+    const Receiver receiver( "drops" );
+    logger::SyslogSink sink( "test" );
+    ASSERT_TRUE( sink.open( receiver.path() ) );
+
+    /* Nobody reads, the sink drops records instead of waiting. */
+    const std::string text( 1000, 'x' );
+    for ( std::int32_t i = 0; i < 10000; i++ ) {
+
+      sink.write( logger::Entry { logger::Severity::Info, {}, {}, 0, {}, text, 0, {} } );
+    }
+    const std::uint64_t dropped = sink.dropped();
+    EXPECT_GT( dropped, 0 );
+    EXPECT_EQ( receiver.receive().size() + dropped, 10000 );
+
+    /* The next delivered record is preceded by the number of dropped records. */
+    sink.write( logger::Entry { logger::Severity::Info, {}, {}, 0, {}, "again", 0, {} } );
+    const std::vector datagrams = receiver.receive();
+    ASSERT_EQ( datagrams.size(), 2 );
+    EXPECT_TRUE( datagrams[ 0 ].starts_with( "<12>1 " ) );
+    EXPECT_TRUE( datagrams[ 0 ].ends_with( " - - dropped " + std::to_string( dropped ) + " records, the syslog socket was full" ) );
+    EXPECT_TRUE( datagrams[ 1 ].ends_with( " - - again" ) );
+    EXPECT_EQ( sink.dropped(), dropped );
+  }
+
+  TEST( LoggerSyslog, Reconnect ) {
+
+    logger::SyslogSink sink( "test" );
+    std::string path {};
+    {
+      const Receiver receiver( "reconnect" );
+      path = receiver.path();
+      ASSERT_TRUE( sink.open( path ) );
+    }
+
+    /* The syslog daemon is gone, the record is dropped. */
+    sink.write( logger::Entry { logger::Severity::Info, {}, {}, 0, {}, "lost", 0, {} } );
+    EXPECT_EQ( sink.dropped(), 1 );
+
+    /* The restarted syslog daemon receives the warning and the record. */
+    const Receiver receiver( "reconnect" );
+    sink.write( logger::Entry { logger::Severity::Info, {}, {}, 0, {}, "found", 0, {} } );
+    const std::vector datagrams = receiver.receive();
+    ASSERT_EQ( datagrams.size(), 2 );
+    EXPECT_TRUE( datagrams[ 0 ].ends_with( " - - dropped 1 records, the syslog socket was full" ) );
+    EXPECT_TRUE( datagrams[ 1 ].ends_with( " - - found" ) );
+  }
+
+  TEST( LoggerSyslog, Closed ) {
+
+    logger::SyslogSink sink {};
+    EXPECT_FALSE( sink.isOpen() );
+    EXPECT_FALSE( sink.open( "/tmp/vx.syslog.test.missing" ) );
+    sink.write( logger::Entry { logger::Severity::Info, {}, {}, 0, {}, "lost", 0, {} } );
+    EXPECT_EQ( sink.dropped(), 1 );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}